@@ -8,7 +8,7 @@ input.string.n_strands = input.string.n_strands + 1;
 savejson('', input, 'input.bow');
 
 % Run a static simulation
-system('virtualbow-slv --static input.bow output.res');
+system('virtualbow-slv --static --msgpack input.bow output.res');
 
 % Load the result file
 output = loadmsgpack('output.res');
@@ -19,6 +19,6 @@ Hk_back = output.setup.limb_properties.layers{1}.Hk_back;
 
 epsilon = output.statics.states.epsilon(:,end);
 kappa   = output.statics.states.kappa(:,end);
-sigma = He_back*epsilon + Hk_back*kappa;
+sigma = He_back.*epsilon + Hk_back.*kappa;
 
 disp(max(sigma));
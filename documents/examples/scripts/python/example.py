@@ -14,7 +14,7 @@ with open("input.bow", "w") as file:
     json.dump(input, file, indent=2)
 
 # Run a static simulation
-subprocess.call(["virtualbow-slv", "--static", "input.bow", "output.res"])
+subprocess.call(["virtualbow-slv", "--static", "--msgpack", "input.bow", "output.res"])
 
 # Load the result file
 with open("output.res", "rb") as file:
@@ -26,6 +26,6 @@ Hk_back = np.array(output["setup"]["limb_properties"]["layers"][0]["Hk_back"])
 
 epsilon = np.array(output["statics"]["states"]["epsilon"][-1])
 kappa   = np.array(output["statics"]["states"]["kappa"][-1])
-sigma = He_back.dot(epsilon) + Hk_back.dot(kappa)
+sigma = He_back*epsilon + Hk_back*kappa
 
 print(sigma.max())
@@ -0,0 +1,99 @@
+#include "Benchmark.hpp"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+// Function-local static to avoid depending on the initialization order of the registrations
+static std::vector<std::pair<std::string, Benchmark::Function>>& registry()
+{
+    static std::vector<std::pair<std::string, Benchmark::Function>> benchmarks;
+    return benchmarks;
+}
+
+void Benchmark::add(const std::string& name, const Function& function)
+{
+    registry().push_back({name, function});
+}
+
+std::vector<std::string> Benchmark::names()
+{
+    std::vector<std::string> result;
+    for(auto& entry: registry()) {
+        result.push_back(entry.first);
+    }
+
+    return result;
+}
+
+// Runs all benchmarks whose name contains the filter string, in the order of registration
+std::vector<Benchmark::Result> Benchmark::run(const std::string& filter, const Settings& settings, const std::function<void(const Result&)>& callback)
+{
+    std::vector<Result> results;
+    for(auto& entry: registry()) {
+        if(entry.first.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        Benchmark benchmark(entry.first, settings);
+        entry.second(benchmark);
+
+        if(benchmark.result.samples == 0) {
+            throw std::runtime_error("Benchmark " + entry.first + " didn't measure anything");
+        }
+
+        results.push_back(benchmark.result);
+        callback(benchmark.result);
+    }
+
+    return results;
+}
+
+void Benchmark::max_samples(unsigned n)
+{
+    settings.samples = std::clamp(settings.samples, 1u, n);
+}
+
+void Benchmark::counter(const std::string& name, const nlohmann::json& value)
+{
+    result.counters[name] = value;
+}
+
+Benchmark::Benchmark(const std::string& name, const Settings& settings)
+    : settings(settings)
+{
+    this->settings.samples = std::max(settings.samples, 1u);
+    result.name = name;
+}
+
+void Benchmark::evaluate(const std::vector<double>& times)
+{
+    std::vector<double> sorted = times;
+    std::sort(sorted.begin(), sorted.end());
+
+    size_t n = sorted.size();
+    result.samples = n;
+    result.min = sorted.front();
+    result.median = (n % 2 == 1) ? sorted[n/2] : 0.5*(sorted[n/2 - 1] + sorted[n/2]);
+    result.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0)/n;
+
+    double variance = 0.0;
+    for(double t: sorted) {
+        variance += (t - result.mean)*(t - result.mean);
+    }
+
+    result.stddev = (n > 1) ? std::sqrt(variance/(n - 1)) : 0.0;
+}
+
+void to_json(nlohmann::json& obj, const Benchmark::Result& result)
+{
+    obj = {
+        {"name", result.name},
+        {"samples", result.samples},
+        {"iterations", result.iterations},
+        {"min", result.min},
+        {"median", result.median},
+        {"mean", result.mean},
+        {"stddev", result.stddev},
+        {"counters", result.counters}
+    };
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <nlohmann/json.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+// Minimal benchmark framework. Benchmark functions are registered with BENCHMARK_CASE(name), similar to test cases,
+// and call measure(f) with the code to be timed. The code is run repeatedly in a number of samples, each of which
+// is long enough for a reliable measurement. The results are the statistics of the time per iteration over the samples.
+
+class Benchmark
+{
+public:
+    using Function = std::function<void(Benchmark&)>;
+
+    struct Settings {
+        unsigned samples = 10;         // Number of samples per benchmark
+        double min_sample_time = 0.01;  // Minimum duration of a sample in seconds
+    };
+
+    struct Result {
+        std::string name;
+        unsigned samples = 0;
+        unsigned long iterations = 0;    // Iterations per sample
+
+        // Time per iteration in seconds
+        double min = 0.0;
+        double median = 0.0;
+        double mean = 0.0;
+        double stddev = 0.0;
+
+        nlohmann::json counters = nlohmann::json::object();    // Additional values, e.g. to check that the results don't change
+    };
+
+    static void add(const std::string& name, const Function& function);
+    static std::vector<std::string> names();
+    static std::vector<Result> run(const std::string& filter, const Settings& settings, const std::function<void(const Result&)>& callback);
+
+    // Times the function f, only the last call of measure in a benchmark counts
+    template<class F>
+    void measure(F&& f);
+
+    // Limits the number of samples, e.g. for long running benchmarks
+    void max_samples(unsigned n);
+
+    // Records an additional value
+    void counter(const std::string& name, const nlohmann::json& value);
+
+private:
+    Settings settings;
+    Result result;
+
+    Benchmark(const std::string& name, const Settings& settings);
+    void evaluate(const std::vector<double>& times);
+};
+
+template<class F>
+void Benchmark::measure(F&& f)
+{
+    using clock = std::chrono::steady_clock;
+
+    // Increase the number of iterations until they take at least the minimum sample time, which also serves as warmup
+    unsigned long iterations = 1;
+    while(true) {
+        auto t0 = clock::now();
+        for(unsigned long j = 0; j < iterations; ++j) {
+            f();
+        }
+
+        double t = std::chrono::duration<double>(clock::now() - t0).count();
+        if(t >= settings.min_sample_time) {
+            break;
+        }
+
+        iterations *= (t > 0.0) ? std::clamp<unsigned long>(std::ceil(1.2*settings.min_sample_time/t), 2, 10) : 10;    // Magic numbers
+    }
+
+    std::vector<double> times;
+    for(unsigned i = 0; i < settings.samples; ++i) {
+        auto t1 = clock::now();
+        for(unsigned long j = 0; j < iterations; ++j) {
+            f();
+        }
+        times.push_back(std::chrono::duration<double>(clock::now() - t1).count()/iterations);
+    }
+
+    result.iterations = iterations;
+    evaluate(times);
+}
+
+void to_json(nlohmann::json& obj, const Benchmark::Result& result);
+
+// Registers a benchmark function at program start
+struct BenchmarkRegistration {
+    BenchmarkRegistration(const std::string& name, const Benchmark::Function& function) {
+        Benchmark::add(name, function);
+    }
+};
+
+#define BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_IMPL(a, b)
+
+#define BENCHMARK_CASE(name) \
+    static void BENCHMARK_CONCAT(benchmark_function_, __LINE__)(Benchmark& benchmark); \
+    static BenchmarkRegistration BENCHMARK_CONCAT(benchmark_registration_, __LINE__)(name, BENCHMARK_CONCAT(benchmark_function_, __LINE__)); \
+    static void BENCHMARK_CONCAT(benchmark_function_, __LINE__)(Benchmark& benchmark)
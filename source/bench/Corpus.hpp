@@ -0,0 +1,14 @@
+#pragma once
+#include "solver/model/input/InputData.hpp"
+#include <string>
+#include <vector>
+
+// Reference bows for the benchmarks. These are copies of example bows that are kept unchanged,
+// so that benchmark results stay comparable between releases. The directory is set by the build system.
+
+static const std::vector<std::string> CORPUS = {"recurve", "longbow", "flatbow", "holmegaard"};
+
+inline InputData load_bow(const std::string& name)
+{
+    return InputData(std::string(VIRTUALBOW_BENCH_BOWS) + "/" + name + ".bow");
+}
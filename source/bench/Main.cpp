@@ -0,0 +1,96 @@
+#include "Benchmark.hpp"
+#include "config.hpp"
+#include <nlohmann/json.hpp>
+#include <iostream>
+#include <fstream>
+#include <thread>
+
+// Runs the benchmarks and writes the results as JSON, either to stdout or to a file.
+// Progress is printed to stderr.
+
+static void print_usage()
+{
+    std::cout << "Usage: virtualbow-bench [options]\n"
+              << "  --list               List the available benchmarks\n"
+              << "  --filter <text>      Only run benchmarks whose name contains the text\n"
+              << "  --samples <n>        Number of samples per benchmark (default: 10)\n"
+              << "  --min-time <s>       Minimum duration of a sample in seconds (default: 0.01)\n"
+              << "  --output <path>      Write the results to a file instead of stdout\n"
+              << "  --help               Show this help\n";
+}
+
+int main(int argc, char* argv[])
+{
+    std::string filter;
+    std::string output;
+    Benchmark::Settings settings;
+
+    try {
+        for(int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if(i + 1 >= argc) {
+                    throw std::invalid_argument("Missing value for " + arg);
+                }
+                return argv[++i];
+            };
+
+            if(arg == "--help") {
+                print_usage();
+                return 0;
+            }
+            else if(arg == "--list") {
+                for(auto& name: Benchmark::names()) {
+                    std::cout << name << std::endl;
+                }
+                return 0;
+            }
+            else if(arg == "--filter") {
+                filter = value();
+            }
+            else if(arg == "--samples") {
+                settings.samples = std::stoul(value());
+            }
+            else if(arg == "--min-time") {
+                settings.min_sample_time = std::stod(value());
+            }
+            else if(arg == "--output") {
+                output = value();
+            }
+            else {
+                throw std::invalid_argument("Unknown argument " + arg);
+            }
+        }
+
+        auto results = Benchmark::run(filter, settings, [](const Benchmark::Result& result) {
+            std::cerr << result.name << ": " << result.median << " s" << std::endl;
+        });
+
+        nlohmann::json obj = {
+            {"version", Config::APPLICATION_VERSION},
+            {"settings", {
+                {"samples", settings.samples},
+                {"min_sample_time", settings.min_sample_time}
+            }},
+            {"system", {
+                {"threads", std::thread::hardware_concurrency()}
+            }},
+            {"benchmarks", results}
+        };
+
+        if(output.empty()) {
+            std::cout << obj.dump(4) << std::endl;
+        }
+        else {
+            std::ofstream stream(output);
+            stream.exceptions(~std::ofstream::goodbit);    // Make stream throw exception on failure
+            stream << obj.dump(4) << std::endl;
+        }
+
+        return 0;
+    }
+    catch(const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
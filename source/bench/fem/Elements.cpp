@@ -0,0 +1,124 @@
+#include "bench/Benchmark.hpp"
+#include "solver/fem/System.hpp"
+#include "solver/fem/elements/BeamElement.hpp"
+#include "solver/fem/elements/BarElement.hpp"
+#include "solver/fem/elements/ContactHandler.hpp"
+#include <cmath>
+
+// Assembly of the internal forces and the tangent stiffness matrix for systems that consist of one type of element.
+// The systems are slightly deformed, the displacements are modified before each evaluation to force a recomputation.
+
+static const unsigned N = 100;    // Number of elements
+
+// Straight chain of beam elements, clamped at one end
+static void create_beams(System& system)
+{
+    std::vector<Node> nodes;
+    for(unsigned i = 0; i < N + 1; ++i) {
+        bool active = (i != 0);
+        nodes.push_back(system.create_node({active, active, active}, {double(i)/N, 0.0, 0.0}));
+    }
+
+    for(unsigned i = 0; i < N; ++i) {
+        BeamElement element(system, nodes[i], nodes[i+1], 1.0, 1.0/N);
+        element.set_stiffness(1e6, 1e2, 0.0);
+        element.set_damping(1e-3);
+        system.mut_elements().add(element);
+    }
+
+    for(size_t i = 0; i < system.dofs(); ++i) {
+        system.mut_u()(i) += 1e-3*std::sin(double(i));
+    }
+}
+
+// Straight chain of bar elements, fixed at one end
+static void create_bars(System& system)
+{
+    std::vector<Node> nodes;
+    for(unsigned i = 0; i < N + 1; ++i) {
+        bool active = (i != 0);
+        nodes.push_back(system.create_node({active, active, false}, {double(i)/N, 0.0, 0.0}));
+    }
+
+    for(unsigned i = 0; i < N; ++i) {
+        system.mut_elements().add(BarElement(system, nodes[i], nodes[i+1], 1.0/N, 1e6, 1e-3, 1.0));
+    }
+
+    for(size_t i = 0; i < system.dofs(); ++i) {
+        system.mut_u()(i) += 1e-3*std::sin(double(i));
+    }
+}
+
+// Fixed segments along the x axis and points slightly above them, about half of which are in contact
+static void create_contacts(System& system)
+{
+    ContactHandler handler(system, ContactForce(1e6, 1e-3));
+
+    Node previous = system.create_node({false, false, false}, {0.0, 0.0, 0.0});
+    for(unsigned i = 1; i < N + 1; ++i) {
+        Node node = system.create_node({false, false, false}, {double(i)/N, 0.0, 0.0});
+        handler.add_segment(previous, node, 0.01, 0.01);
+        previous = node;
+    }
+
+    for(unsigned i = 0; i < N; ++i) {
+        double y = (i % 2 == 0) ? 0.009 : 0.02;
+        handler.add_point(system.create_node({true, true, false}, {(i + 0.5)/N, y, 0.0}));
+    }
+
+    system.mut_elements().add(handler);
+}
+
+// Runs the benchmarks for the internal forces and the tangent stiffness of a system
+static void measure_assembly(Benchmark& benchmark, const std::function<void(System&)>& create, bool stiffness)
+{
+    System system;
+    create(system);
+
+    double sign = 1.0;
+    benchmark.measure([&]{
+        sign = -sign;
+        system.mut_u()(system.dofs() - 1) += sign*1e-9;
+        if(stiffness) {
+            system.get_K();
+        }
+        else {
+            system.get_q();
+        }
+    });
+
+    benchmark.counter("dofs", system.dofs());
+    for(auto& handler: system.get_elements().group<ContactHandler>("")) {
+        benchmark.counter("contacts", handler.get_counts().active);
+    }
+}
+
+BENCHMARK_CASE("fem/beam-elements/internal-forces")
+{
+    measure_assembly(benchmark, create_beams, false);
+}
+
+BENCHMARK_CASE("fem/beam-elements/tangent-stiffness")
+{
+    measure_assembly(benchmark, create_beams, true);
+}
+
+BENCHMARK_CASE("fem/bar-elements/internal-forces")
+{
+    measure_assembly(benchmark, create_bars, false);
+}
+
+BENCHMARK_CASE("fem/bar-elements/tangent-stiffness")
+{
+    measure_assembly(benchmark, create_bars, true);
+}
+
+BENCHMARK_CASE("fem/contact-elements/internal-forces")
+{
+    measure_assembly(benchmark, create_contacts, false);
+}
+
+BENCHMARK_CASE("fem/contact-elements/tangent-stiffness")
+{
+    measure_assembly(benchmark, create_contacts, true);
+}
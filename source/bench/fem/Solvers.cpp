@@ -0,0 +1,92 @@
+#include "bench/Benchmark.hpp"
+#include "solver/fem/System.hpp"
+#include "solver/fem/StaticSolver.hpp"
+#include "solver/fem/DynamicSolver.hpp"
+#include "solver/fem/EigenvalueSolver.hpp"
+#include "solver/fem/elements/BeamElement.hpp"
+
+// Solvers applied to a cantilever beam with a tip load, similar to the large deformation test case
+
+struct Cantilever {
+    System system;
+    std::vector<Node> nodes;
+    unsigned N;    // Number of elements
+
+    Cantilever(unsigned N = 100)
+        : N(N)
+    {
+        const double L = 2.0;
+        const double E = 2.07e11;
+        const double A = 0.01;
+        const double I = 8.33e-6;
+
+        for(unsigned i = 0; i < N + 1; ++i) {
+            bool active = (i != 0);
+            nodes.push_back(system.create_node({active, active, active}, {double(i)/N*L, 0.0, 0.0}));
+        }
+
+        for(unsigned i = 0; i < N; ++i) {
+            BeamElement element(system, nodes[i], nodes[i+1], 7850*A, L/N);
+            element.set_stiffness(E*A, E*I, 0.0);
+            element.set_damping(1e-4);
+            system.mut_elements().add(element);
+        }
+
+        system.set_p(nodes[N].y, 3.0*E*I/(L*L));
+    }
+};
+
+BENCHMARK_CASE("fem/static-solver/load-control")
+{
+    Cantilever cantilever;
+    VectorXd u0 = cantilever.system.get_u();
+    StaticSolverLC::Info info;
+
+    benchmark.measure([&]{
+        cantilever.system.set_u(u0);
+        StaticSolverLC solver(cantilever.system);
+        info = solver.solve();
+    });
+
+    benchmark.counter("iterations", info.iterations);
+    benchmark.counter("tip_displacement", cantilever.system.get_u(cantilever.nodes.back().y));
+}
+
+BENCHMARK_CASE("fem/dynamic-solver/step")
+{
+    Cantilever cantilever;
+    DynamicSolver solver(cantilever.system, DynamicSolver::AdaptiveTimestep{0.5}, 1e4, []{ return false; });
+
+    benchmark.measure([&]{
+        solver.step();
+    });
+
+    benchmark.counter("timestep", solver.get_timestep());
+}
+
+// Fewer elements for the eigenvalue solver, like the limbs of the reference bows
+BENCHMARK_CASE("fem/eigenvalue-solver/minimum-frequency")
+{
+    Cantilever cantilever(40);
+    double omega = 0.0;
+
+    benchmark.measure([&]{
+        EigenvalueSolver solver(cantilever.system);
+        omega = solver.compute_minimum_frequency().omega;
+    });
+
+    benchmark.counter("omega", omega);
+}
+
+BENCHMARK_CASE("fem/eigenvalue-solver/maximum-frequency")
+{
+    Cantilever cantilever(40);
+    double omega = 0.0;
+
+    benchmark.measure([&]{
+        EigenvalueSolver solver(cantilever.system);
+        omega = solver.compute_maximum_frequency().omega;
+    });
+
+    benchmark.counter("omega", omega);
+}
@@ -0,0 +1,47 @@
+#include "bench/Benchmark.hpp"
+#include "bench/Corpus.hpp"
+#include "solver/model/ContinuousLimb.hpp"
+#include "solver/numerics/Linspace.hpp"
+
+// Evaluation of the cross sections of a reference bow at many arc lengths, one by one and on a grid.
+
+static const unsigned N_EVAL = 1000;    // Number of evaluations per iteration
+
+static void measure_limb(Benchmark& benchmark, bool grid)
+{
+    ContinuousLimb limb(load_bow("recurve"));
+    std::vector<double> args = linspace(0.0, limb.length(), N_EVAL);
+
+    double sum = 0.0;
+    if(grid) {
+        SectionGrid sections;
+        benchmark.measure([&]{
+            limb.evaluate(args, sections);
+            sum = 0.0;
+            for(size_t i = 0; i < args.size(); ++i) {
+                sum += sections.width[i] + sections.height[i] + sections.y.back()[i] + sections.rhoA[i] + sections.Ckk[i];
+            }
+        });
+    }
+    else {
+        benchmark.measure([&]{
+            sum = 0.0;
+            for(double arg: args) {
+                limb.get_r(arg);
+                sum += limb.get_w(arg) + limb.get_h(arg) + limb.get_y(arg).back() + limb.get_rhoA(arg) + limb.get_C(arg)(1, 1);
+            }
+        });
+    }
+
+    benchmark.counter("sum", sum);
+}
+
+BENCHMARK_CASE("model/continuous-limb/single")
+{
+    measure_limb(benchmark, false);
+}
+
+BENCHMARK_CASE("model/continuous-limb/grid")
+{
+    measure_limb(benchmark, true);
+}
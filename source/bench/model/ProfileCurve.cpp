@@ -0,0 +1,47 @@
+#include "bench/Benchmark.hpp"
+#include "bench/Corpus.hpp"
+#include "solver/model/profile/ProfileCurve.hpp"
+#include "solver/numerics/Linspace.hpp"
+#include <algorithm>
+#include <random>
+
+// Evaluation of the profile curve of a reference bow at many arc lengths, in ascending and in random order.
+// The curve remembers the segment of the last evaluation, so the order matters.
+
+static const unsigned N_EVAL = 1000;    // Number of evaluations per iteration
+
+static std::vector<double> shuffled(std::vector<double> args)
+{
+    std::mt19937 generator(0);    // Fixed seed, same order in every run
+    std::shuffle(args.begin(), args.end(), generator);
+    return args;
+}
+
+static void measure_profile(Benchmark& benchmark, bool random)
+{
+    ProfileCurve curve(load_bow("recurve").profile);
+    std::vector<double> args = linspace(0.0, curve.length(), N_EVAL);
+    if(random) {
+        args = shuffled(args);
+    }
+
+    double sum = 0.0;
+    benchmark.measure([&]{
+        sum = 0.0;
+        for(double arg: args) {
+            sum += curve.position(arg)[1] + curve.angle(arg) + curve.curvature(arg);
+        }
+    });
+
+    benchmark.counter("sum", sum);
+}
+
+BENCHMARK_CASE("model/profile-curve/ascending")
+{
+    measure_profile(benchmark, false);
+}
+
+BENCHMARK_CASE("model/profile-curve/random")
+{
+    measure_profile(benchmark, true);
+}
@@ -0,0 +1,58 @@
+#include "bench/Benchmark.hpp"
+#include "bench/Corpus.hpp"
+#include "solver/model/BowModel.hpp"
+#include <filesystem>
+#include <numeric>
+
+// Saving and loading the result of a dynamic simulation of a reference bow in both file formats.
+// Loading a binary file only maps the state arrays, so accessing them is measured as well.
+
+static void measure_save(Benchmark& benchmark, OutputData::Format format)
+{
+    OutputData output = BowModel::simulate(load_bow("recurve"), SimulationMode::Dynamic, [](int, int){});
+    std::string path = (std::filesystem::temp_directory_path() / "virtualbow-bench.res").string();
+
+    benchmark.measure([&]{
+        output.save(path, format);
+    });
+
+    benchmark.counter("bytes", std::filesystem::file_size(path));
+    std::filesystem::remove(path);
+}
+
+static void measure_load(Benchmark& benchmark, OutputData::Format format)
+{
+    OutputData output = BowModel::simulate(load_bow("recurve"), SimulationMode::Dynamic, [](int, int){});
+    std::string path = (std::filesystem::temp_directory_path() / "virtualbow-bench.res").string();
+    output.save(path, format);
+
+    double sum = 0.0;
+    benchmark.measure([&]{
+        OutputData loaded(path);
+        const StateArray& kappa = loaded.dynamics.states.kappa;
+        sum = std::accumulate(kappa.data(), kappa.data() + kappa.size()*kappa.cols(), 0.0);
+    });
+
+    benchmark.counter("sum_kappa", sum);
+    std::filesystem::remove(path);
+}
+
+BENCHMARK_CASE("model/result-files/save-binary")
+{
+    measure_save(benchmark, OutputData::Format::Binary);
+}
+
+BENCHMARK_CASE("model/result-files/save-msgpack")
+{
+    measure_save(benchmark, OutputData::Format::MsgPack);
+}
+
+BENCHMARK_CASE("model/result-files/load-binary")
+{
+    measure_load(benchmark, OutputData::Format::Binary);
+}
+
+BENCHMARK_CASE("model/result-files/load-msgpack")
+{
+    measure_load(benchmark, OutputData::Format::MsgPack);
+}
@@ -0,0 +1,42 @@
+#include "bench/Benchmark.hpp"
+#include "bench/Corpus.hpp"
+#include "solver/model/BowModel.hpp"
+
+// Complete static and dynamic simulations of the reference bows with different numbers of limb elements.
+// The counters contain some of the results, so that changes of the results can be noticed along with changes of the timing.
+
+static void measure_simulation(Benchmark& benchmark, const std::string& bow, int n_elements, SimulationMode mode)
+{
+    InputData input = load_bow(bow);
+    input.settings.n_limb_elements = n_elements;
+
+    OutputData output;
+    benchmark.max_samples(3);    // Magic number
+    benchmark.measure([&]{
+        output = BowModel::simulate(input, mode, [](int, int){});
+    });
+
+    benchmark.counter("final_draw_force", output.statics.final_draw_force);
+    benchmark.counter("drawing_work", output.statics.drawing_work);
+    if(mode == SimulationMode::Dynamic) {
+        benchmark.counter("final_vel_arrow", output.dynamics.final_vel_arrow);
+        benchmark.counter("efficiency", output.dynamics.efficiency);
+        benchmark.counter("states", output.dynamics.states.time.size());
+    }
+}
+
+// Registers the benchmarks for all combinations of bow, number of elements and simulation mode
+static bool registered = []{
+    for(auto& mode: {std::make_pair("static", SimulationMode::Static), std::make_pair("dynamic", SimulationMode::Dynamic)}) {
+        for(auto& bow: CORPUS) {
+            for(int n_elements: {20, 40, 80}) {
+                std::string name = std::string("model/simulation/") + mode.first + "/" + bow + "/" + std::to_string(n_elements);
+                Benchmark::add(name, [=](Benchmark& benchmark) {
+                    measure_simulation(benchmark, bow, n_elements, mode.second);
+                });
+            }
+        }
+    }
+
+    return true;
+}();
@@ -0,0 +1,76 @@
+#include "bench/Benchmark.hpp"
+#include "solver/numerics/CubicSpline.hpp"
+#include "solver/numerics/Linspace.hpp"
+#include <algorithm>
+#include <random>
+#include <cmath>
+
+// Evaluation of splines at many arguments, in ascending and in random order, one by one and in a single batch.
+// Single evaluations search the interval of each argument, batches of sorted arguments can skip the search.
+
+static const unsigned N_EVAL = 1000;    // Number of evaluations per iteration
+
+static std::vector<double> shuffled(std::vector<double> args)
+{
+    std::mt19937 generator(0);    // Fixed seed, same order in every run
+    std::shuffle(args.begin(), args.end(), generator);
+    return args;
+}
+
+static void measure_spline(Benchmark& benchmark, bool random, bool batch)
+{
+    std::vector<double> x = linspace(0.0, 1.0, 50);
+    std::vector<double> y;
+    for(double xi: x) {
+        y.push_back(std::sin(5.0*xi));
+    }
+
+    CubicSpline spline(x, y);
+    std::vector<double> args = linspace(0.0, 1.0, N_EVAL);
+    if(random) {
+        args = shuffled(args);
+    }
+
+    double sum = 0.0;
+    if(batch) {
+        std::vector<double> vals;
+        std::vector<double> deriv1;
+        benchmark.measure([&]{
+            spline.evaluate(args, &vals, &deriv1);
+            sum = 0.0;
+            for(size_t i = 0; i < args.size(); ++i) {
+                sum += vals[i] + deriv1[i];
+            }
+        });
+    }
+    else {
+        benchmark.measure([&]{
+            sum = 0.0;
+            for(double arg: args) {
+                sum += spline(arg) + spline.deriv1(arg);
+            }
+        });
+    }
+
+    benchmark.counter("sum", sum);
+}
+
+BENCHMARK_CASE("numerics/cubic-spline/ascending")
+{
+    measure_spline(benchmark, false, false);
+}
+
+BENCHMARK_CASE("numerics/cubic-spline/random")
+{
+    measure_spline(benchmark, true, false);
+}
+
+BENCHMARK_CASE("numerics/cubic-spline/batch-ascending")
+{
+    measure_spline(benchmark, false, true);
+}
+
+BENCHMARK_CASE("numerics/cubic-spline/batch-random")
+{
+    measure_spline(benchmark, true, true);
+}
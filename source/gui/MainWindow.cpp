@@ -1,5 +1,6 @@
 #include "MainWindow.hpp"
 #include "SimulationDialog.hpp"
+#include "ResultWindow.hpp"
 #include "RecentFilesMenu.hpp"
 #include "HelpMenu.hpp"
 #include "treedock/TreeDock.hpp"
@@ -17,6 +18,7 @@
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QApplication>
+#include <QFileInfo>
 
 MainWindow::MainWindow()
     : view_model(new ViewModel()),
@@ -49,13 +51,13 @@ MainWindow::MainWindow()
     action_quit->setMenuRole(QAction::QuitRole);
 
     auto action_run_statics = new QAction(QIcon(":/icons/run-statics"), "&Statics...", this);
-    QObject::connect(action_run_statics, &QAction::triggered, [&]{ runSimulation("--static"); });
+    QObject::connect(action_run_statics, &QAction::triggered, [&]{ runSimulation(SimulationMode::Static); });
     action_run_statics->setShortcut(Qt::Key_F5);
     action_run_statics->setMenuRole(QAction::NoRole);
     action_run_statics->setIconVisibleInMenu(true);
 
     auto action_run_dynamics = new QAction(QIcon(":/icons/run-dynamics"), "&Dynamics...", this);
-    QObject::connect(action_run_dynamics, &QAction::triggered, [&]{ runSimulation("--dynamic"); });
+    QObject::connect(action_run_dynamics, &QAction::triggered, [&]{ runSimulation(SimulationMode::Dynamic); });
     action_run_dynamics->setShortcut(Qt::Key_F6);
     action_run_dynamics->setMenuRole(QAction::NoRole);
     action_run_dynamics->setIconVisibleInMenu(true);
@@ -252,23 +254,13 @@ bool MainWindow::saveAs() {
     return false;
 }
 
-void MainWindow::runSimulation(const QString& flag) {
-    if(!save()) {
-        return;
-    }
-
-    // Generate output filename
-    QFileInfo info(this->windowFilePath());
-    QString output_file = info.absolutePath() + QDir::separator() + info.completeBaseName() + ".res";
-
-    // Run Simulation, launch Post on results if successful
-    SimulationDialog dialog(this, this->windowFilePath(), output_file, flag);
+// Simulates the current state of the model in the background and shows the results in a new window if successful.
+// The model doesn't have to be saved for this and the results are only written to disk if the user chooses to.
+void MainWindow::runSimulation(SimulationMode mode) {
+    SimulationDialog dialog(this, view_model->getData(), mode);
     if(dialog.exec() == QDialog::Accepted) {
-        QProcess::startDetached(
-            QDir(QCoreApplication::applicationDirPath()).filePath("virtualbow-post"),
-            { output_file },
-            QCoreApplication::applicationDirPath()
-        );
+        auto window = new ResultWindow(this, dialog.getOutput(), QFileInfo(view_model->displayPath()).completeBaseName());
+        window->show();
     }
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "solver/model/input/InputData.hpp"
+#include "solver/model/BowModel.hpp"
 #include <QMainWindow>
 
 class RecentFilesMenu;
@@ -26,7 +27,7 @@ private:
     bool save();
     bool saveAs();
 
-    void runSimulation(const QString& flag);
+    void runSimulation(SimulationMode mode);
 
     bool optionalSaveModifications();
     QString showOpenFileDialog();
@@ -0,0 +1,60 @@
+#include "ResultWindow.hpp"
+#include "post/OutputWidget.hpp"
+#include "gui/utils/UserSettings.hpp"
+#include <QMenuBar>
+#include <QMessageBox>
+#include <QFileDialog>
+
+ResultWindow::ResultWindow(QWidget* parent, OutputData&& data, const QString& name)
+    : QMainWindow(parent),
+      data(std::move(data)),
+      name(name)
+{
+    auto action_save_as = new QAction(QIcon(":/icons/document-save-as.svg"), "Save &As...", this);
+    action_save_as->setShortcuts(QKeySequence::SaveAs);
+    action_save_as->setMenuRole(QAction::NoRole);
+    QObject::connect(action_save_as, &QAction::triggered, this, &ResultWindow::saveAs);
+
+    auto action_close = new QAction("&Close", this);
+    action_close->setShortcuts(QKeySequence::Close);
+    action_close->setMenuRole(QAction::NoRole);
+    QObject::connect(action_close, &QAction::triggered, this, &QWidget::close);
+
+    auto menu_file = this->menuBar()->addMenu("&File");
+    menu_file->addAction(action_save_as);
+    menu_file->addSeparator();
+    menu_file->addAction(action_close);
+
+    // Deleted when closed, since the editor can open any number of result windows
+    this->setAttribute(Qt::WA_DeleteOnClose);
+    this->setWindowIcon(QIcon(":/icons/logo.svg"));
+    this->setWindowTitle(name + " - Results");
+    this->setCentralWidget(new OutputWidget(this->data));
+    this->resize(INITIAL_SIZE);
+
+    UserSettings settings;
+    restoreGeometry(settings.value("ResultWindow/geometry").toByteArray());
+}
+
+void ResultWindow::closeEvent(QCloseEvent *event) {
+    UserSettings settings;
+    settings.setValue("ResultWindow/geometry", saveGeometry());
+}
+
+void ResultWindow::saveAs() {
+    QFileDialog dialog(this);
+    dialog.setAcceptMode(QFileDialog::AcceptSave);
+    dialog.setNameFilter("Result Files (*.res)");
+    dialog.setDefaultSuffix("res");
+    dialog.selectFile(name);
+
+    if(dialog.exec() == QDialog::Accepted) {
+        QString path = dialog.selectedFiles().first();
+        try {
+            data.save(path.toLocal8Bit().toStdString());    // toLocal8Bit() for Windows, since toStdString() would convert to UTF8
+        }
+        catch(const std::exception& e) {
+            QMessageBox::critical(this, "Error", "Failed to save " + path + ":\n" + e.what());
+        }
+    }
+}
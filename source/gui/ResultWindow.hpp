@@ -0,0 +1,19 @@
+#pragma once
+#include "solver/model/output/OutputData.hpp"
+#include <QMainWindow>
+
+// Shows the results of a simulation that was run by the model editor.
+// The results are only kept in memory unless the user saves them.
+class ResultWindow: public QMainWindow {
+public:
+    ResultWindow(QWidget* parent, OutputData&& data, const QString& name);
+
+private:
+    const QSize INITIAL_SIZE = {1000, 700};
+
+    OutputData data;
+    QString name;
+
+    void closeEvent(QCloseEvent *event) override;
+    void saveAs();
+};
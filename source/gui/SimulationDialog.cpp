@@ -1,15 +1,18 @@
 #include "SimulationDialog.hpp"
+#include "SimulationThread.hpp"
+#include "post/OutputWidget.hpp"
 #include <QVBoxLayout>
 #include <QProgressBar>
 #include <QMessageBox>
 #include <QLabel>
-#include <QProcess>
 #include <QDialogButtonBox>
-#include <QCoreApplication>
-#include <QDir>
+#include <QTimer>
 
-SimulationDialog::SimulationDialog(QWidget* parent, const QString& input, const QString& output, const QString& flag)
-    : DialogBase(parent)
+SimulationDialog::SimulationDialog(QWidget* parent, const InputData& input, SimulationMode mode)
+    : DialogBase(parent),
+      thread(new SimulationThread(this, input, mode)),
+      input(input),
+      live(nullptr)
 {
     auto vbox = new QVBoxLayout();
     this->setLayout(vbox);
@@ -26,59 +29,80 @@ SimulationDialog::SimulationDialog(QWidget* parent, const QString& input, const
 
     // Create dynamic progress bar
     QProgressBar* progress2 = nullptr;
-    if(flag == "--dynamic") {
+    if(mode == SimulationMode::Dynamic) {
         progress2 = new QProgressBar();
         progress2->setMinimumWidth(350);    // Magic number
-		progress2->setTextVisible(false);    // Looks bad on Windows otherwise
+        progress2->setTextVisible(false);    // Looks bad on Windows otherwise
         vbox->addWidget(new QLabel("Dynamics"));
         vbox->addWidget(progress2);
     }
 
+    // Poll the dynamic states of the simulation and show them once available
+    if(mode == SimulationMode::Dynamic) {
+        auto timer = new QTimer(this);
+        timer->setInterval(100);    // Magic number
+        QObject::connect(timer, &QTimer::timeout, this, &SimulationDialog::readStates);
+        QObject::connect(thread, &QThread::finished, timer, &QTimer::stop);
+        timer->start();
+    }
+
     // Create buttons
     auto btbox = new QDialogButtonBox(QDialogButtonBox::Cancel);
     QObject::connect(btbox, &QDialogButtonBox::rejected, this, &QDialog::reject);
     vbox->addSpacing(8);    // Magic number
     vbox->addWidget(btbox);
 
-    // Create solver process
-    auto process = new QProcess(this);
-    process->setWorkingDirectory(QCoreApplication::applicationDirPath());
-    process->setProgram(QDir(QCoreApplication::applicationDirPath()).filePath("virtualbow-slv"));
-    process->setArguments({ input, output, flag, "--progress" });
-
     QObject::connect(this, &QDialog::rejected, this, [=] {
-        // User canceled the dialog: Terminate process and wait until it has finished
-        process->terminate();
-        process->waitForFinished();
+        // User canceled the dialog: Stop the simulation and wait until the thread has finished
+        thread->cancel();
+        thread->wait();
     });
 
-    QObject::connect(process, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
-	this, [=](int exitCode, QProcess::ExitStatus exitStatus) {
-        // Accept the dialog if the process finished successfully
-        // Otherwise show its error output, if there are any
-        // (there are none if the process was terminated by the user)
-        if(exitStatus == QProcess::NormalExit && exitCode == 0) {
+    QObject::connect(thread, &QThread::finished, this, [=] {
+        // Accept the dialog if the simulation finished successfully, otherwise show the error, if there is one
+        // (there is none if the simulation was canceled by the user)
+        if(thread->isSuccessful()) {
             this->accept();
-        } else {
-            QString error(process->readAllStandardError());
-            if(!error.isEmpty()) {
-                QMessageBox::critical(this, "Error", error);
-                this->reject();
-            }
+        }
+        else if(!thread->isCanceled()) {
+            QMessageBox::critical(this, "Error", thread->getError());
+            this->reject();
         }
     });
 
-    QObject::connect(process, &QProcess::readyRead, this, [=] {
-        QString line(process->readAll());
-        if(progress1 != nullptr) {
-            progress1->setValue(line.section("\t", 0, 0).toInt());
-        }
+    QObject::connect(thread, &SimulationThread::progress, this, [=](int p1, int p2) {
+        progress1->setValue(p1);
         if(progress2 != nullptr) {
-            progress2->setValue(line.section("\t", 1, 1).toInt());
+            progress2->setValue(p2);
         }
     });
 
-    process->start();
+    thread->start();
+}
+
+void SimulationDialog::readStates() {
+    if(!thread->readStates(states)) {
+        return;
+    }
+
+    if(live != nullptr) {
+        live->appendStates();
+    }
+    else if(states.time.size() >= 2) {    // The plots need at least two states
+        limb = LimbProperties(input);    // The input is valid at this point, since the simulation got past the setup
+
+        live = new LiveOutputWidget(limb, states);
+        live->setMinimumSize(600, 400);    // Magic numbers
+
+        // Insert above the buttons and let the dialog be resized from now on
+        auto vbox = static_cast<QVBoxLayout*>(this->layout());
+        vbox->insertWidget(vbox->count() - 2, live, 1);
+        vbox->setSizeConstraint(QLayout::SetDefaultConstraint);
+    }
+}
+
+OutputData SimulationDialog::getOutput() {
+    return thread->takeOutput();
 }
 
 void SimulationDialog::closeEvent(QCloseEvent *event)
@@ -1,13 +1,30 @@
 #pragma once
 #include "gui/widgets/DialogBase.hpp"
+#include "solver/model/BowModel.hpp"
+#include "solver/model/LimbProperties.hpp"
 
+class SimulationThread;
+class LiveOutputWidget;
+
+// Runs a simulation in the background and shows its progress, as well as the states of a dynamic simulation while they are computed.
+// The dialog is accepted when the simulation was successful, the results are then available from getOutput().
 class SimulationDialog: public DialogBase
 {
     Q_OBJECT
 
 public:
-    SimulationDialog(QWidget* parent, const QString& input, const QString& output, const QString& flag);
+    SimulationDialog(QWidget* parent, const InputData& input, SimulationMode mode);
+    OutputData getOutput();
 
 private:
+    SimulationThread* thread;
+
+    InputData input;
+    LimbProperties limb;       // Limb of the simulated model, same as in the results
+    BowStates states;          // Dynamic states published so far
+    LiveOutputWidget* live;    // Created when the first states are available
+
+    void readStates();
+
     void closeEvent(QCloseEvent *event) override;
 };
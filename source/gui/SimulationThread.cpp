@@ -0,0 +1,60 @@
+#include "SimulationThread.hpp"
+
+SimulationThread::SimulationThread(QObject* parent, const InputData& input, SimulationMode mode)
+    : QThread(parent),
+      input(input),
+      mode(mode),
+      canceled(false),
+      stream(memory),
+      success(false)
+{
+
+}
+
+void SimulationThread::cancel() {
+    canceled = true;
+}
+
+bool SimulationThread::isCanceled() const {
+    return canceled;
+}
+
+bool SimulationThread::isSuccessful() const {
+    return success;
+}
+
+const QString& SimulationThread::getError() const {
+    return error;
+}
+
+OutputData SimulationThread::takeOutput() {
+    return std::move(output);
+}
+
+bool SimulationThread::readStates(BowStates& states) {
+    return stream.read(states);
+}
+
+void SimulationThread::run() {
+    try {
+        // Only changes in progress are reported, since each signal is queued to the receiving thread
+        std::pair<int, int> previous = {-1, -1};
+
+        output = BowModel::simulate(input, mode, [&](int p1, int p2) {
+            if(p1 != previous.first || p2 != previous.second) {
+                previous = {p1, p2};
+                emit progress(p1, p2);
+            }
+        }, stream, [&] {
+            return canceled.load();
+        });
+
+        success = true;
+    }
+    catch(const SimulationCanceled&) {
+        // Canceled by the user, no error
+    }
+    catch(const std::exception& e) {
+        error = QString::fromStdString(e.what());
+    }
+}
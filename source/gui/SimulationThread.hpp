@@ -0,0 +1,42 @@
+#pragma once
+#include "solver/model/BowModel.hpp"
+#include <QThread>
+#include <atomic>
+
+// Runs a simulation in the background. The progress is reported by a signal and the dynamic states can be read while the thread runs,
+// the results or the error message are available after it has finished.
+class SimulationThread: public QThread
+{
+    Q_OBJECT
+
+public:
+    SimulationThread(QObject* parent, const InputData& input, SimulationMode mode);
+
+    // Requests the simulation to stop at the next check inside the solver loops
+    void cancel();
+    bool isCanceled() const;
+
+    bool isSuccessful() const;
+    const QString& getError() const;
+    OutputData takeOutput();
+
+    // Appends the dynamic states that were published since the last call, returns false if there were none
+    bool readStates(BowStates& states);
+
+signals:
+    void progress(int statics, int dynamics);
+
+private:
+    InputData input;
+    SimulationMode mode;
+    std::atomic<bool> canceled;
+
+    MemorySink memory;
+    StreamSink stream;
+
+    OutputData output;
+    QString error;
+    bool success;
+
+    void run() override;
+};
@@ -16,6 +16,10 @@ LimbMesh::LimbMesh(const InputData& input)
         size_t n_layers = limb.get_layers().size();
         size_t n_segments = lengths.size() - 1;
 
+        SectionGrid grid;
+        limb.evaluate(lengths, grid);
+        const auto& y = grid.y;
+
         // Transition points between layers at the left and right of the previous and next cross section
         std::vector<QVector3D> points_l_prev(n_layers+1);
         std::vector<QVector3D> points_l_next(n_layers+1);
@@ -29,22 +33,16 @@ LimbMesh::LimbMesh(const InputData& input)
 
         // Iterate over segments, i.e. pairs of a previous and a next cross section
         for(size_t i = 0; i < n_segments; ++i) {
-            Vector<3> profile_prev = limb.get_r(lengths[i]);
-            Vector<3> profile_next = limb.get_r(lengths[i+1]);
-
-            QVector3D center_prev  ( profile_prev[0], profile_prev[1], 0.0 );
+            QVector3D center_prev  ( grid.x_pos[i], grid.y_pos[i], 0.0 );
             QVector3D normal_w_prev( 0.0, 0.0, 1.0 );
-            QVector3D normal_h_prev(-sin(profile_prev[2]), cos(profile_prev[2]), 0.0 );
+            QVector3D normal_h_prev(-sin(grid.angle[i]), cos(grid.angle[i]), 0.0 );
 
-            QVector3D center_next  ( profile_next[0], profile_next[1], 0.0 );
+            QVector3D center_next  ( grid.x_pos[i+1], grid.y_pos[i+1], 0.0 );
             QVector3D normal_w_next( 0.0, 0.0, 1.0 );
-            QVector3D normal_h_next(-sin(profile_next[2]), cos(profile_next[2]), 0.0 );
-
-            double w_prev = limb.get_w(lengths[i]);
-            double w_next = limb.get_w(lengths[i+1]);
+            QVector3D normal_h_next(-sin(grid.angle[i+1]), cos(grid.angle[i+1]), 0.0 );
 
-            auto y_prev = limb.get_y(lengths[i]);
-            auto y_next = limb.get_y(lengths[i+1]);
+            double w_prev = grid.width[i];
+            double w_next = grid.width[i+1];
 
             points_l_prev.clear();
             points_l_next.clear();
@@ -52,16 +50,16 @@ LimbMesh::LimbMesh(const InputData& input)
             points_r_next.clear();
 
             for(size_t j = 0; j < n_layers + 1; ++j) {
-                points_r_prev.push_back(center_prev + 0.5*w_prev*normal_w_prev + y_prev[j]*normal_h_prev);
-                points_r_next.push_back(center_next + 0.5*w_next*normal_w_next + y_next[j]*normal_h_next);
-                points_l_prev.push_back(center_prev - 0.5*w_prev*normal_w_prev + y_prev[j]*normal_h_prev);
-                points_l_next.push_back(center_next - 0.5*w_next*normal_w_next + y_next[j]*normal_h_next);
+                points_r_prev.push_back(center_prev + 0.5*w_prev*normal_w_prev + y[j][i]*normal_h_prev);
+                points_r_next.push_back(center_next + 0.5*w_next*normal_w_next + y[j][i+1]*normal_h_next);
+                points_l_prev.push_back(center_prev - 0.5*w_prev*normal_w_prev + y[j][i]*normal_h_prev);
+                points_l_next.push_back(center_next - 0.5*w_next*normal_w_next + y[j][i+1]*normal_h_next);
             }
 
             // Sides
             for(size_t j = 0; j < n_layers; ++j) {
                 // Only layers with height != 0
-                if(y_prev[j] != y_prev[j+1] || y_next[j] != y_next[j+1]) {
+                if(y[j][i] != y[j+1][i] || y[j][i+1] != y[j+1][i+1]) {
                     // Left
                     addQuad(points_l_prev[j], points_l_next[j], points_l_next[j+1], points_l_prev[j+1], colors[j]);
 
@@ -82,7 +80,7 @@ LimbMesh::LimbMesh(const InputData& input)
             // Back
             for(size_t j = 0; j < n_layers; ++j) {
                 // Find first layer with height != 0
-                if(y_prev[j] != y_prev[j+1] || y_next[j] != y_next[j+1]) {
+                if(y[j][i] != y[j+1][i] || y[j][i+1] != y[j+1][i+1]) {
                     addQuad(points_l_prev[j], points_r_prev[j], points_r_next[j], points_l_next[j], colors[j]);
                     break;
                 }
@@ -91,7 +89,7 @@ LimbMesh::LimbMesh(const InputData& input)
             // Belly
             for(size_t j = n_layers; j > 0; --j) {
                 // Find first layer with height != 0
-                if(y_prev[j] != y_prev[j-1] || y_next[j] != y_next[j-1]) {
+                if(y[j][i] != y[j-1][i] || y[j][i+1] != y[j-1][i+1]) {
                     addQuad(points_l_prev[j], points_l_next[j], points_r_next[j], points_r_prev[j], colors[j-1]);
                     break;
                 }
@@ -77,3 +77,18 @@ void ComboPlot::updatePlot() {
     plot->rescaleAxes();
     plot->replot();
 }
+
+void ComboPlot::appendData() {
+    const std::vector<double>& data_x = *data[combo_x->currentIndex()];
+    const std::vector<double>& data_y = *data[combo_y->currentIndex()];
+
+    Unit unit_x = quantities[combo_x->currentIndex()]->getUnit();
+    Unit unit_y = quantities[combo_y->currentIndex()]->getUnit();
+
+    for(size_t i = curve->dataCount(); i < std::min(data_x.size(), data_y.size()); ++i) {
+        curve->addData(unit_x.fromBase(data_x[i]), unit_y.fromBase(data_y[i]));
+    }
+
+    plot->rescaleAxes();
+    plot->replot();
+}
@@ -10,6 +10,9 @@ public:
     void addData(const QString& name, const std::vector<double>& data, const Quantity& quantity);
     void setCombination(int index_x, int index_y);
 
+    // Plots the values that were appended to the data since the last update
+    void appendData();
+
 private:
     QList<const std::vector<double>*> data;
     QList<const Quantity*> quantities;
@@ -5,6 +5,7 @@ CurvaturePlot::CurvaturePlot(const LimbProperties& limb, const BowStates& states
     : limb(limb),
       states(states),
       index(0),
+      axes_outdated(false),
       quantity_length(Quantities::length),
       quantity_curvature(Quantities::curvature)
 {
@@ -23,6 +24,15 @@ void CurvaturePlot::setStateIndex(int i) {
     this->replot();
 }
 
+void CurvaturePlot::showEvent(QShowEvent* event) {
+    if(axes_outdated) {
+        updateAxes();
+        this->replot();
+    }
+
+    PlotWidget::showEvent(event);
+}
+
 void CurvaturePlot::updatePlot() {
     updateCurvature();
     updateAxes();
@@ -38,6 +48,11 @@ void CurvaturePlot::updateCurvature() {
 
 
 void CurvaturePlot::updateAxes() {
+    axes_outdated = !this->isVisible();
+    if(axes_outdated) {
+        return;
+    }
+
     this->xAxis->setLabel("Arc length " + quantity_length.getUnit().getLabel());
     this->yAxis->setLabel("Curvature " + quantity_curvature.getUnit().getLabel());
 
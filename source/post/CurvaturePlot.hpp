@@ -9,10 +9,14 @@ public:
     CurvaturePlot(const LimbProperties& limb, const BowStates& states);
     void setStateIndex(int i);
 
+protected:
+    void showEvent(QShowEvent* event) override;
+
 private:
     const LimbProperties& limb;
     const BowStates& states;
     int index;
+    bool axes_outdated;    // The axis limits need all states and are only updated when the plot is visible
 
     const Quantity& quantity_length;
     const Quantity& quantity_curvature;
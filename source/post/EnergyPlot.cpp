@@ -1,6 +1,4 @@
 #include "EnergyPlot.hpp"
-#include <algorithm>
-#include <functional>
 
 EnergyPlot::EnergyPlot(const BowStates& states, const std::vector<double>& parameter, const QString& label_x, const Quantity& quantity_x, const Quantity& quantity_y)
     : states(states),
@@ -11,7 +9,8 @@ EnergyPlot::EnergyPlot(const BowStates& states, const std::vector<double>& param
       plot(new PlotWidget()),
       cb_stacked(new QCheckBox("Stacked")),
       cb_part(new QCheckBox("Group by component")),
-      cb_type(new QCheckBox("Group by type"))
+      cb_type(new QCheckBox("Group by type")),
+      n_states(0)
 {
     plot->setupTopLegend();
 
@@ -57,106 +56,113 @@ void EnergyPlot::setStateIndex(int index) {
 
 }
 
-void EnergyPlot::updatePlot() {
-    plot->xAxis->setLabel(label_x + " " + quantity_x.getUnit().getLabel());
-    plot->yAxis->setLabel("Energy " + quantity_y.getUnit().getLabel());
-
-    // Function plot_energy adds a single energy to the plot
-    std::function<void(const std::vector<double>& energy, const QString& name, const QColor& color)> plot_energy;
-
-    // Select plot_energy and alpha for plotting either stacked or single lines
-    if(cb_stacked->isChecked()) {
-        std::vector<double> e_lower;
-        std::vector<double> e_upper(parameter.size());
-
-        plot_energy = [&, e_lower, e_upper](const std::vector<double>& energy, const QString& name, QColor color) mutable {
-            color.setAlpha(155);
+void EnergyPlot::appendStates() {
+    // A new graph changes the stacking and the legend, so the plot is recreated if an energy becomes nonzero
+    for(size_t k = 0; k < energies.size(); ++k) {
+        if(graphs[k] == nullptr && !isZero(energies[k], n_states, parameter.size())) {
+            updatePlot();
+            return;
+        }
+    }
 
-            // Test if energy is nonzero
-            if(std::none_of(energy.begin(), energy.end(), [](double e) { return e > 0.0; })) {
-                return;
-            }
+    addStates(n_states, parameter.size());
+    plot->rescaleAxes(false, true);
+    plot->replot();
+}
 
-            e_lower = e_upper;
-            for(size_t i = 0; i < parameter.size(); ++i) {
-                e_upper[i] += energy[i];
-            }
+// Energies depending on the grouping option
+std::vector<EnergyPlot::Energy> EnergyPlot::getEnergies() const {
+    if(cb_part->isChecked()) {
+        return {
+            {"Limbs (Total)", QColor(0, 0, 255), [this](size_t i) { return states.e_pot_limbs[i] + states.e_kin_limbs[i]; }},
+            {"String (Total)", QColor(128, 0, 128), [this](size_t i) { return states.e_pot_string[i] + states.e_kin_string[i]; }},
+            {"Arrow (Total)", QColor(255, 0, 0), [this](size_t i) { return states.e_kin_arrow[i]; }}
+        };
+    }
+    else if(cb_type->isChecked()) {
+        return {
+            {"Potential", QColor(0, 0, 255), [this](size_t i) { return states.e_pot_limbs[i] + states.e_pot_string[i]; }},
+            {"Kinetic", QColor(255, 0, 0), [this](size_t i) { return states.e_kin_limbs[i] + states.e_kin_string[i] + states.e_kin_arrow[i]; }}
+        };
+    }
+    else {
+        return {
+            {"Limbs (Pot)", QColor(0, 0, 255), [this](size_t i) { return states.e_pot_limbs[i]; }},
+            {"Limbs (Kin)", QColor(40, 40, 255), [this](size_t i) { return states.e_kin_limbs[i]; }},
+            {"String (Pot)", QColor(128, 0, 128), [this](size_t i) { return states.e_pot_string[i]; }},
+            {"String (Kin)", QColor(128, 40, 128), [this](size_t i) { return states.e_kin_string[i]; }},
+            {"Arrow (Kin)", QColor(255, 0, 0), [this](size_t i) { return states.e_kin_arrow[i]; }}
+        };
+    }
+}
 
-            auto graph_lower = plot->graph();
-            auto graph_upper = plot->addGraph();
+// Test if energy is zero at the states begin ... end - 1
+bool EnergyPlot::isZero(const Energy& energy, size_t begin, size_t end) const {
+    for(size_t i = begin; i < end; ++i) {
+        if(energy.value(i) > 0.0) {
+            return false;
+        }
+    }
 
-            graph_upper->setData(
-                quantity_x.getUnit().fromBase(parameter),
-                quantity_y.getUnit().fromBase(e_upper)
-            );
-            graph_upper->setName(name);
-            graph_upper->setBrush(color);
-            graph_upper->setPen({QBrush(color), 2.0});
+    return true;
+}
 
-            if(graph_lower != nullptr) {
-                graph_upper->setChannelFillGraph(graph_lower);
+// Adds the states begin ... end - 1 to the graphs, either stacked or as single lines
+void EnergyPlot::addStates(size_t begin, size_t end) {
+    for(size_t i = begin; i < end; ++i) {
+        double e_upper = 0.0;
+        for(size_t k = 0; k < energies.size(); ++k) {
+            if(graphs[k] != nullptr) {
+                double e = energies[k].value(i);
+                e_upper += e;
+
+                graphs[k]->addData(
+                    quantity_x.getUnit().fromBase(parameter[i]),
+                    cb_stacked->isChecked() ? quantity_y.getUnit().fromBase(e_upper) : quantity_x.getUnit().fromBase(e)
+                );
             }
-        };
+        }
     }
-    else {
-        plot_energy = [&](const std::vector<double>& energy, const QString& name, QColor color) {
-            color.setAlpha(255);
 
-            // Test if energy is nonzero
-            if(std::none_of(energy.begin(), energy.end(), [](double e) { return e > 0.0; })) {
-                return;
-            }
+    n_states = end;
+}
 
-            auto graph = plot->addGraph();
-            graph->setData(
-                quantity_x.getUnit().fromBase(parameter),
-                quantity_x.getUnit().fromBase(energy)
-            );
-            graph->setName(name);
-            graph->setPen({QBrush(color), 2.0});
-        };
-    }
+void EnergyPlot::updatePlot() {
+    plot->xAxis->setLabel(label_x + " " + quantity_x.getUnit().getLabel());
+    plot->yAxis->setLabel("Energy " + quantity_y.getUnit().getLabel());
 
     // Clear plot
     plot->clearPlottables();
 
-    // Use plot_energy to plot the energies depending on the grouping option
-    if(cb_part->isChecked()) {
-        std::vector<double> e_limbs(parameter.size());
-        std::vector<double> e_string(parameter.size());
+    // Add a graph for each nonzero energy
+    energies = getEnergies();
+    graphs.assign(energies.size(), nullptr);
 
-        for(size_t i = 0; i < parameter.size(); ++i) {
-            e_limbs[i] = states.e_pot_limbs[i] + states.e_kin_limbs[i];
-        }
-        for(size_t i = 0; i < parameter.size(); ++i) {
-            e_string[i] = states.e_pot_string[i] + states.e_kin_string[i];
+    QCPGraph* graph_lower = nullptr;
+    for(size_t k = 0; k < energies.size(); ++k) {
+        if(isZero(energies[k], 0, parameter.size())) {
+            continue;
         }
-        plot_energy(e_limbs, "Limbs (Total)", QColor(0, 0, 255));
-        plot_energy(e_string, "String (Total)", QColor(128, 0, 128));
-        plot_energy(states.e_kin_arrow, "Arrow (Total)", QColor(255, 0, 0));
-    }
-    else if(cb_type->isChecked()) {
-        std::vector<double> e_pot(parameter.size());
-        std::vector<double> e_kin(parameter.size());
 
-        for(size_t i = 0; i < parameter.size(); ++i) {
-            e_pot[i] = states.e_pot_limbs[i] + states.e_pot_string[i];
-        }
-        for(size_t i = 0; i < parameter.size(); ++i) {
-            e_kin[i] = states.e_kin_limbs[i] + states.e_kin_string[i] + states.e_kin_arrow[i];
+        QColor color = energies[k].color;
+        color.setAlpha(cb_stacked->isChecked() ? 155 : 255);
+
+        graphs[k] = plot->addGraph();
+        graphs[k]->setName(energies[k].name);
+        graphs[k]->setPen({QBrush(color), 2.0});
+
+        if(cb_stacked->isChecked()) {
+            graphs[k]->setBrush(color);
+            if(graph_lower != nullptr) {
+                graphs[k]->setChannelFillGraph(graph_lower);
+            }
         }
 
-        plot_energy(e_pot, "Potential", QColor(0, 0, 255));
-        plot_energy(e_kin, "Kinetic", QColor(255, 0, 0));
-    }
-    else {
-        plot_energy(states.e_pot_limbs, "Limbs (Pot)", QColor(0, 0, 255));
-        plot_energy(states.e_kin_limbs, "Limbs (Kin)", QColor(40, 40, 255));
-        plot_energy(states.e_pot_string, "String (Pot)", QColor(128, 0, 128));
-        plot_energy(states.e_kin_string, "String (Kin)", QColor(128, 40, 128));
-        plot_energy(states.e_kin_arrow, "Arrow (Kin)", QColor(255, 0, 0));
+        graph_lower = graphs[k];
     }
 
+    addStates(0, parameter.size());
+
     // Update plot
     plot->rescaleAxes(false, true);
     plot->replot();
@@ -2,12 +2,16 @@
 #include "gui/widgets/PlotWidget.hpp"
 #include "gui/viewmodel/units/UnitSystem.hpp"
 #include "solver/model/output/OutputData.hpp"
+#include <functional>
 
 class EnergyPlot: public QWidget {
 public:
     EnergyPlot(const BowStates& states, const std::vector<double>& parameter, const QString& label_x, const Quantity& quantity_x, const Quantity& quantity_y);
     void setStateIndex(int index);
 
+    // Plots the states that were appended since the last update
+    void appendStates();
+
 private:
     const BowStates& states;
     const std::vector<double>& parameter;
@@ -21,5 +25,19 @@ private:
     QCheckBox* cb_part;
     QCheckBox* cb_type;
 
+    // Energy at a state index
+    struct Energy {
+        QString name;
+        QColor color;
+        std::function<double(size_t)> value;
+    };
+
+    std::vector<Energy> energies;     // Energies of the current grouping
+    std::vector<QCPGraph*> graphs;    // Graph of each energy, nullptr if the energy is zero so far
+    size_t n_states;                  // Number of plotted states
+
+    std::vector<Energy> getEnergies() const;
+    bool isZero(const Energy& energy, size_t begin, size_t end) const;
+    void addStates(size_t begin, size_t end);
     void updatePlot();
 };
@@ -108,7 +108,7 @@ StaticOutputWidget::StaticOutputWidget(const OutputData& data)
     numbers->addValue("String force (strand)", data.statics.states.strand_force[data.statics.max_string_force_index],  Quantities::force);
 
     auto plot_shapes = new ShapePlot(data.setup.limb_properties, data.statics.states, 4);
-    auto plot_stress = new StressPlot(data.setup.limb_properties, data.statics.states);
+    auto plot_stress = new StressPlot(data.setup.limb_properties, data.statics.states, data.statics.min_stress_value, data.statics.max_stress_value);
     auto plot_curvature = new CurvaturePlot(data.setup.limb_properties, data.statics.states);
     auto plot_energy = new EnergyPlot(data.statics.states, data.statics.states.draw_length, "Draw length", Quantities::length, Quantities::energy);
     auto plot_combo = new ComboPlot();
@@ -188,7 +188,7 @@ DynamicOutputWidget::DynamicOutputWidget(const OutputData& data)
     numbers->addValue("Grip force", data.dynamics.states.grip_force[data.dynamics.max_grip_force_index], Quantities::force);
 
     auto plot_shapes = new ShapePlot(data.setup.limb_properties, data.dynamics.states, 0);
-    auto plot_stress = new StressPlot(data.setup.limb_properties, data.dynamics.states);
+    auto plot_stress = new StressPlot(data.setup.limb_properties, data.dynamics.states, data.dynamics.min_stress_value, data.dynamics.max_stress_value);
     auto plot_curvature = new CurvaturePlot(data.setup.limb_properties, data.dynamics.states);
     auto plot_energy = new EnergyPlot(data.dynamics.states, data.dynamics.states.time, "Time", Quantities::time, Quantities::energy);
     auto plot_combo = new ComboPlot();
@@ -241,3 +241,40 @@ DynamicOutputWidget::~DynamicOutputWidget() {
     UserSettings settings;
     settings.setValue("DynamicOutputWidget/selectedTab", tabs->currentIndex());
 }
+
+
+LiveOutputWidget::LiveOutputWidget(const LimbProperties& limb, const BowStates& states)
+    : plot_shapes(new ShapePlot(limb, states, 0)),
+      plot_energy(new EnergyPlot(states, states.time, "Time", Quantities::time, Quantities::energy)),
+      plot_combo(new ComboPlot()),
+      slider(new Slider(states.time, "Time", Quantities::time))
+{
+    plot_combo->addData("Time", states.time, Quantities::time);
+    plot_combo->addData("Arrow position", states.pos_arrow, Quantities::position);
+    plot_combo->addData("Arrow velocity", states.vel_arrow, Quantities::velocity);
+    plot_combo->addData("Arrow acceleration", states.acc_arrow, Quantities::acceleration);
+    plot_combo->addData("String force (total)", states.string_force, Quantities::force);
+    plot_combo->addData("Grip force", states.grip_force, Quantities::force);
+    plot_combo->setCombination(0, 2);
+
+    auto tabs = new QTabWidget();
+    tabs->addTab(plot_shapes, "Shape");
+    tabs->addTab(plot_energy, "Energy");
+    tabs->addTab(plot_combo, "Other Plots");
+
+    QObject::connect(slider, &Slider::indexChanged, plot_shapes, &ShapePlot::setStateIndex);
+    slider->setIndex(states.time.size() - 1);
+
+    auto vbox = new QVBoxLayout();
+    this->setLayout(vbox);
+    vbox->setMargin(0);
+    vbox->addWidget(tabs);
+    vbox->addWidget(slider);
+}
+
+void LiveOutputWidget::appendStates() {
+    slider->appendValues();
+    plot_shapes->appendStates();
+    plot_energy->appendStates();
+    plot_combo->appendData();
+}
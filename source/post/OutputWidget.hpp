@@ -4,6 +4,10 @@
 
 class QPushButton;
 class QTabWidget;
+class ShapePlot;
+class EnergyPlot;
+class ComboPlot;
+class Slider;
 
 class OutputWidget: public QWidget {
 public:
@@ -34,3 +38,17 @@ public:
 private:
     QTabWidget* tabs;
 };
+
+// Shows the dynamic states of a running simulation. The states are owned by the caller and may grow,
+// appendStates() updates the plots with the new states. The slider follows the last state unless moved by the user.
+class LiveOutputWidget: public QWidget {
+public:
+    LiveOutputWidget(const LimbProperties& limb, const BowStates& states);
+    void appendStates();
+
+private:
+    ShapePlot* plot_shapes;
+    EnergyPlot* plot_energy;
+    ComboPlot* plot_combo;
+    Slider* slider;
+};
@@ -5,7 +5,9 @@ ShapePlot::ShapePlot(const LimbProperties& limb, const BowStates& states, int ba
       states(states),
       quantity(Quantities::length),
       background_states(background_states),
-      index(0)
+      index(0),
+      n_states(0),
+      axes_outdated(false)
 {
     this->setAspectPolicy(PlotWidget::SCALE_Y);
 
@@ -66,6 +68,15 @@ void ShapePlot::setStateIndex(int i) {
     this->replot();
 }
 
+void ShapePlot::showEvent(QShowEvent* event) {
+    if(axes_outdated) {
+        updateAxes();
+        this->replot();
+    }
+
+    PlotWidget::showEvent(event);
+}
+
 void ShapePlot::updatePlot() {
     updateBackgroundStates();
     updateCurrentState();
@@ -117,13 +128,32 @@ void ShapePlot::updateCurrentState() {
     );
 }
 
+void ShapePlot::appendStates() {
+    if(!axes_outdated) {
+        expandAxes();
+    }
+
+    this->replot();
+}
+
 void ShapePlot::updateAxes() {
+    axes_outdated = !this->isVisible();
+    if(axes_outdated) {
+        return;
+    }
+
     this->xAxis->setLabel("X " + quantity.getUnit().getLabel());
     this->yAxis->setLabel("Y " + quantity.getUnit().getLabel());
 
-    QCPRange x_range;
-    QCPRange y_range;
+    x_range = QCPRange();
+    y_range = QCPRange();
+    n_states = 0;
 
+    expandAxes();
+}
+
+// Expands the axis limits by the unbraced limb and the states that weren't included yet
+void ShapePlot::expandAxes() {
     auto expand = [&](const VectorXd& x_values, const VectorXd& y_values) {
         for(size_t i = 0; i < x_values.size(); ++i) {
             x_range.expand(quantity.getUnit().fromBase( x_values[i]));
@@ -132,13 +162,17 @@ void ShapePlot::updateAxes() {
         }
     };
 
-    expand(limb.x_pos, limb.y_pos);
-    for(size_t i = 0; i < states.time.size(); ++i) {
+    if(n_states == 0) {
+        expand(limb.x_pos, limb.y_pos);
+    }
+
+    for(size_t i = n_states; i < states.time.size(); ++i) {
         // Add 0.5*height as an estimated upper bound
         expand(states.x_pos_limb[i] + 0.5*limb.height, states.y_pos_limb[i] + 0.5*limb.height);
         expand(states.x_pos_string[i], states.y_pos_string[i]);
     }
 
+    n_states = states.time.size();
     this->setAxesLimits(x_range, y_range);
 }
 
@@ -8,6 +8,12 @@ public:
     ShapePlot(const LimbProperties& limb, const BowStates& states, int background_states);
     void setStateIndex(int i);
 
+    // Extends the axes to the states that were appended since the last update
+    void appendStates();
+
+protected:
+    void showEvent(QShowEvent* event) override;
+
 private:
     const LimbProperties& limb;
     const BowStates& states;
@@ -16,6 +22,12 @@ private:
     int background_states;
     int index;
 
+    // Axis limits of the states up to n_states. They need all states and are only updated when the plot is visible.
+    QCPRange x_range;
+    QCPRange y_range;
+    size_t n_states;
+    bool axes_outdated;
+
     QList<QCPCurve*> limb_right;
     QList<QCPCurve*> limb_left;
     QList<QCPCurve*> string_right;
@@ -27,6 +39,7 @@ private:
     void updateBackgroundStates();
     void updateCurrentState();
     void updateAxes();
+    void expandAxes();
 
     void plotLimbOutline(QCPCurve* left, QCPCurve* right, const VectorXd& x, const VectorXd& y, const VectorXd& phi);
 };
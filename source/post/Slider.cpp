@@ -16,16 +16,19 @@ Slider::Slider(const std::vector<double>& values, const QString& text, const Qua
       label(new QLabel()),
       slider(new QSlider(Qt::Horizontal)),
       menu(new QMenu()),
+      timer(new QTimer(this)),
+      validator(new QDoubleValidator(this)),
       values(values),
       text(text),
       quantity(quantity),
-      index(0)
+      index(0),
+      delta_i(1)
 {
     const int height = 30; // Magic number
 
     edit = new QLineEdit();
     edit->setFixedHeight(height);
-    edit->setValidator(new QDoubleValidator(values.front(), values.back(), 10));
+    edit->setValidator(validator);
 
     auto button_jump_to = new QToolButton();
     button_jump_to->setIcon(QIcon(":/icons/media-jump-to.svg"));
@@ -62,13 +65,7 @@ Slider::Slider(const std::vector<double>& values, const QString& text, const Qua
     hbox->addSpacing(10);
     hbox->addWidget(slider, 1);
 
-    // Timer interval and number of steps done by the timer each tick
-    int delta_i = std::ceil(1000*double(values.size() - 1)/(playback_time*playback_max_fps));
-    int delta_t = playback_time*delta_i/(values.size() - 1);
-    slider->setRange(0, values.size()-1);
-
-    auto timer = new QTimer(this);
-    timer->setInterval(delta_t);
+    updateRange();
 
     auto start_playback = [=] {
         timer->start();
@@ -146,6 +143,28 @@ void Slider::addJumpAction(const QString& name, int index) {
     menu->addAction(action);
 }
 
+void Slider::setIndex(int index) {
+    slider->setValue(index);
+}
+
+void Slider::appendValues() {
+    bool at_end = (slider->value() == slider->maximum());
+    updateRange();
+
+    if(at_end) {
+        slider->setValue(slider->maximum());
+    }
+}
+
+// Sets the slider and validator ranges as well as the timer interval and steps according to the number of values
+void Slider::updateRange() {
+    validator->setRange(values.front(), values.back(), 10);
+    slider->setRange(0, values.size()-1);
+
+    delta_i = std::ceil(1000*double(values.size() - 1)/(playback_time*playback_max_fps));
+    timer->setInterval(playback_time*delta_i/(values.size() - 1));
+}
+
 void Slider::updateLabels() {
     double unitValue = quantity.getUnit().fromBase(values[index]);
     edit->setText(QLocale().toString(unitValue));
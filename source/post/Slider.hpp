@@ -6,6 +6,8 @@ class QLineEdit;
 class QLabel;
 class QSlider;
 class QMenu;
+class QTimer;
+class QDoubleValidator;
 
 class Slider: public QWidget {
     Q_OBJECT
@@ -13,6 +15,10 @@ class Slider: public QWidget {
 public:
     Slider(const std::vector<double>& values, const QString& text, const Quantity& quantity);
     void addJumpAction(const QString& name, int index);
+    void setIndex(int index);
+
+    // Updates the range after values were appended. If the last value was selected, the new last value is selected.
+    void appendValues();
 
 signals:
     void indexChanged(int index);
@@ -25,11 +31,15 @@ private:
     QLabel* label;
     QSlider* slider;
     QMenu* menu;
+    QTimer* timer;
+    QDoubleValidator* validator;
 
     const std::vector<double>& values;
     QString text;
     const Quantity& quantity;
     int index;
+    int delta_i;    // Number of steps done by the timer each tick
 
+    void updateRange();
     void updateLabels();
 };
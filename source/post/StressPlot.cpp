@@ -16,9 +16,11 @@ const QList<QColor> COLOR_PALETTE = {
     QColor("#17becf")
 };
 
-StressPlot::StressPlot(const LimbProperties& limb, const BowStates& states)
+StressPlot::StressPlot(const LimbProperties& limb, const BowStates& states, const std::vector<double>& min_stress, const std::vector<double>& max_stress)
     : limb(limb),
       states(states),
+      min_stress(min_stress),
+      max_stress(max_stress),
       index(0),
       quantity_length(Quantities::length),
       quantity_stress(Quantities::stress)
@@ -60,11 +62,11 @@ void StressPlot::updateStresses() {
         const LayerProperties& layer = limb.layers[i];
         this->graph(2*i)->setData(
             quantity_length.getUnit().fromBase(layer.length),
-            quantity_stress.getUnit().fromBase(layer.He_back*states.epsilon[index] + layer.Hk_back*states.kappa[index])
+            quantity_stress.getUnit().fromBase(layer.get_stress_back(states.epsilon[index], states.kappa[index]))
         );
         this->graph(2*i+1)->setData(
             quantity_length.getUnit().fromBase(layer.length),
-            quantity_stress.getUnit().fromBase(layer.He_belly*states.epsilon[index] + layer.Hk_belly*states.kappa[index])
+            quantity_stress.getUnit().fromBase(layer.get_stress_belly(states.epsilon[index], states.kappa[index]))
         );
     }
 }
@@ -82,18 +84,9 @@ void StressPlot::updateAxes() {
         0.0
     );
 
-    for(auto& layer: limb.layers)
-    {
-        for(size_t i = 0; i < states.time.size(); ++i)
-        {
-            VectorXd sigma_back = layer.He_back*states.epsilon[i] + layer.Hk_back*states.kappa[i];
-            VectorXd sigma_belly = layer.He_belly*states.epsilon[i] + layer.Hk_belly*states.kappa[i];
-
-            y_range.expand(quantity_stress.getUnit().fromBase(sigma_back.minCoeff()));
-            y_range.expand(quantity_stress.getUnit().fromBase(sigma_back.maxCoeff()));
-            y_range.expand(quantity_stress.getUnit().fromBase(sigma_belly.minCoeff()));
-            y_range.expand(quantity_stress.getUnit().fromBase(sigma_belly.maxCoeff()));
-        }
+    for(size_t i = 0; i < min_stress.size() && i < max_stress.size(); ++i) {
+        y_range.expand(quantity_stress.getUnit().fromBase(min_stress[i]));
+        y_range.expand(quantity_stress.getUnit().fromBase(max_stress[i]));
     }
 
     this->setAxesLimits(x_range, y_range);
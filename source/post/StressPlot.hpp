@@ -6,12 +6,15 @@
 
 class StressPlot: public PlotWidget {
 public:
-    StressPlot(const LimbProperties& limb, const BowStates& states);
+    // min_stress, max_stress: Stress range of each layer over all states, for the axis limits
+    StressPlot(const LimbProperties& limb, const BowStates& states, const std::vector<double>& min_stress, const std::vector<double>& max_stress);
     void setStateIndex(int i);
 
 private:
     const LimbProperties& limb;
     const BowStates& states;
+    const std::vector<double>& min_stress;
+    const std::vector<double>& max_stress;
     int index;
 
     const Quantity& quantity_length;
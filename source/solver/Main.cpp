@@ -1,8 +1,14 @@
 #include <QtCore>
 #include "config.hpp"
 #include "model/BowModel.hpp"
+#include "model/BatchSimulation.hpp"
+#include "fem/Profiler.hpp"
+#include <algorithm>
 #include <utility>
+#include <optional>
 #include <iostream>
+#include <fstream>
+#include <thread>
 
 int main(int argc, char* argv[]) {
     QCoreApplication::setOrganizationName(Config::ORGANIZATION_NAME);
@@ -14,6 +20,14 @@ int main(int argc, char* argv[]) {
     QCommandLineOption statics({"s", "static"}, "Run a static simulation.");
     QCommandLineOption dynamics({"d", "dynamic"}, "Run a dynamic simulation.");
     QCommandLineOption progress({"p", "progress"}, "Print simulation progress.");
+    QCommandLineOption msgpack("msgpack", "Save the result file in the MessagePack format, e.g. for reading it with scripts.");
+    QCommandLineOption profile("profile", "Save the run times and counters of the simulation phases to a JSON file next to the result file (<result>.profile.json).");
+    QCommandLineOption batch({"b", "batch"}, "Batch mode: Simulate all input files and their parameter variations in parallel.");
+    QCommandLineOption vary("vary", "Batch mode: Vary a model parameter, given by a JSON pointer into the model file, over a list (v1,v2,...) or range (start:end:n) of values. "
+                                    "Can be used multiple times, all combinations are simulated. Example: /string/n_strands=10,12,14", "pointer=values");
+    QCommandLineOption threads({"j", "threads"}, "Batch mode: Number of threads (default: number of cores).", "n");
+    QCommandLineOption directory({"o", "output-dir"}, "Batch mode: Directory for the result files (default: directory of the first input file).", "directory");
+    QCommandLineOption summary("summary", "Batch mode: Summary table of all variants (default: summary.txt in the output directory).", "path");
 
     QCoreApplication application(argc, argv);
     QCommandLineParser parser;
@@ -22,8 +36,15 @@ int main(int argc, char* argv[]) {
     parser.addOption(statics);
     parser.addOption(dynamics);
     parser.addOption(progress);
-    parser.addPositionalArgument("input", "Model file (.bow)");
-    parser.addPositionalArgument("output", "Result file (.res)");
+    parser.addOption(msgpack);
+    parser.addOption(profile);
+    parser.addOption(batch);
+    parser.addOption(vary);
+    parser.addOption(threads);
+    parser.addOption(directory);
+    parser.addOption(summary);
+    parser.addPositionalArgument("input", "Model file (.bow), multiple files in batch mode");
+    parser.addPositionalArgument("output", "Result file (.res), not used in batch mode");
     parser.process(application);
 
     QStringList args = parser.positionalArguments();
@@ -32,22 +53,11 @@ int main(int argc, char* argv[]) {
         parser.showHelp();
         return 0;
     }
-    else if(args.size() > 2) {
+    else if(args.size() > 2 && !parser.isSet(batch)) {
         std::cerr << "Too many arguments." << std::endl;;
         return 1;
     }
 
-    QString input_path = args[0];
-    QString output_path;
-
-    if(args.size() == 2) {
-        output_path = args[1];
-    }
-    else {
-        QFileInfo info(input_path);
-        output_path = info.absolutePath() + QDir::separator() + info.completeBaseName() + ".res";
-    }
-
     try {
         SimulationMode mode;
         if(parser.isSet(dynamics)) {
@@ -61,7 +71,73 @@ int main(int argc, char* argv[]) {
             return 1;
         }
 
+        OutputData::Format format = parser.isSet(msgpack) ? OutputData::Format::MsgPack : OutputData::Format::Binary;
+
+#ifndef VIRTUALBOW_PROFILING
+        if(parser.isSet(profile)) {
+            std::cerr << "Profiling is not available in this build." << std::endl;
+            return 1;
+        }
+#endif
+
+        if(parser.isSet(batch)) {
+            if(parser.isSet(profile)) {
+                std::cerr << "Profiling is not available in batch mode." << std::endl;
+                return 1;
+            }
+
+            std::vector<ParameterRange> ranges;
+            for(auto& text: parser.values(vary)) {
+                ranges.push_back(ParameterRange(text.toStdString()));
+            }
+
+            unsigned n_threads = parser.isSet(threads) ? parser.value(threads).toUInt() : std::thread::hardware_concurrency();
+            QString output_dir = parser.isSet(directory) ? parser.value(directory) : QFileInfo(args[0]).absolutePath();
+            QString summary_path = parser.isSet(summary) ? parser.value(summary) : output_dir + QDir::separator() + "summary.txt";
+
+            // Input files are parsed and the models varied up front, so that each variant only needs to be simulated
+            std::vector<BatchVariant> variants;
+            for(auto& path: args) {
+                InputData input(path.toLocal8Bit().toStdString());    // toLocal8Bit() for Windows, since toStdString() would convert to UTF8
+                auto file_variants = create_variants(QFileInfo(path).completeBaseName().toStdString(), input, ranges);
+                variants.insert(variants.end(), file_variants.begin(), file_variants.end());
+            }
+
+            size_t finished = 0;
+            BatchSimulation simulation(mode, output_dir.toLocal8Bit().toStdString(), n_threads, format);
+            auto summaries = simulation.run(variants, [&](const BatchSummary& summary) {
+                ++finished;
+                if(parser.isSet(progress)) {
+                    std::cout << finished << "\t" << variants.size() << "\t" << summary.name << std::endl;
+                }
+                if(!summary.error.empty()) {
+                    std::cerr << "Error (" << summary.name << "): " << summary.error << std::endl;
+                }
+            });
+
+            BatchSimulation::save_summary(summary_path.toLocal8Bit().toStdString(), ranges, summaries);
+            return std::all_of(summaries.begin(), summaries.end(), [](const BatchSummary& summary) { return summary.error.empty(); }) ? 0 : 1;
+        }
+
+        QString input_path = args[0];
+        QString output_path;
+
+        if(args.size() == 2) {
+            output_path = args[1];
+        }
+        else {
+            QFileInfo info(input_path);
+            output_path = info.absolutePath() + QDir::separator() + info.completeBaseName() + ".res";
+        }
+
         InputData input(input_path.toLocal8Bit().toStdString());    // toLocal8Bit() for Windows, since toStdString() would convert to UTF8
+        FileSink sink(output_path.toLocal8Bit().toStdString());     // Dynamic states are streamed to temporary files next to the result file
+
+        Profiler profiler;
+        std::optional<Profiler::Activation> activation;
+        if(parser.isSet(profile)) {
+            activation.emplace(profiler);
+        }
 
         std::pair<int, int> previous = {-1, -1};
         OutputData output = BowModel::simulate(input, mode, [&](int p1, int p2) {
@@ -71,9 +147,19 @@ int main(int argc, char* argv[]) {
                     std::cout << p1 << "\t" << p2 << std::endl;
                 }
             }
-        });
+        }, sink);
+
+        output.save(output_path.toLocal8Bit().toStdString(), format);    // toLocal8Bit() for Windows, since toStdString() would convert to UTF8
+
+        if(parser.isSet(profile)) {
+            QFileInfo info(output_path);
+            QString profile_path = info.absolutePath() + QDir::separator() + info.completeBaseName() + ".profile.json";
+
+            std::ofstream stream(profile_path.toLocal8Bit().toStdString());
+            stream.exceptions(~std::ofstream::goodbit);    // Make stream throw exception on failure
+            stream << nlohmann::json(profiler).dump(4) << std::endl;
+        }
 
-        output.save(output_path.toLocal8Bit().toStdString());    // toLocal8Bit() for Windows, since toStdString() would convert to UTF8
         return 0;
     }
     catch(const std::exception& e) {
@@ -1,21 +1,33 @@
 #pragma once
 #include <vector>
+#include <utility>
 #include <stdexcept>
 #include <functional>
 
+// Lazy evaluation of values that depend on other values.
+// Every value carries a version number that is incremented whenever it is modified, which makes modification O(1).
+// Dependent values remember the versions of their dependencies at their last update and are only recomputed
+// on access if any of those versions has changed in the meantime (or if a dependency is itself outdated).
+
 // Todo: Remove is_valid() and set_valid() from public interface
 // Todo: Make depends_on(...) variadic
 
-class DependentBase;
-
 class IndependentBase {
 public:
-    void add_dependent(DependentBase& dependent) {
-        dependents.push_back(&dependent);
+    using Version = unsigned long long;
+
+    virtual ~IndependentBase() = default;
+
+    Version get_version() const {
+        return version;
+    }
+
+    virtual bool is_valid() const {
+        return true;
     }
 
 protected:
-    std::vector<DependentBase*> dependents;
+    Version version = 0;
 };
 
 class DependentBase: public IndependentBase {
@@ -27,25 +39,44 @@ public:
     }
 
     void depends_on(IndependentBase& other) {
-        other.add_dependent(*this);
+        dependencies.push_back({&other, other.get_version()});
     }
 
-    bool is_valid() const {
-        return valid;
+    // Valid if it has been updated before and none of the dependencies has changed or become invalid since then
+    bool is_valid() const override {
+        if(!valid) {
+            return false;
+        }
+
+        for(auto& dependency: dependencies) {
+            if(dependency.first->get_version() != dependency.second || !dependency.first->is_valid()) {
+                return false;
+            }
+        }
+
+        return true;
     }
 
+    // Setting valid to true marks the value as up to date with the current versions of its dependencies
     void set_valid(bool val) const {
         valid = val;
 
-        if(!valid) {
-            for(auto d: dependents) {
-                d->set_valid(false);
+        if(valid) {
+            for(auto& dependency: dependencies) {
+                dependency.second = dependency.first->get_version();
             }
         }
     }
 
+    // Number of times the value was recomputed
+    unsigned long get_updates() const {
+        return updates;
+    }
+
 protected:
+    mutable std::vector<std::pair<const IndependentBase*, Version>> dependencies;    // Dependencies and their versions at the last update
     mutable bool valid = false;
+    mutable unsigned long updates = 0;
 };
 
 template<typename T>
@@ -64,10 +95,7 @@ public:
     }
 
     T& mut() {
-        for(auto d: dependents) {
-            d->set_valid(false);
-        }
-
+        ++version;
         return value;
     }
 
@@ -87,6 +115,7 @@ public:
     const T& get() const {
         if(!is_valid()) {
             update();
+            ++updates;
             set_valid(true);
         }
 
@@ -94,10 +123,7 @@ public:
     }
 
     T& mut() {
-        for(auto d: dependents) {
-            d->set_valid(false);
-        }
-
+        ++version;
         return value;
     }
 
@@ -64,3 +64,15 @@ inline void add_by_dof(MatrixXd* mat, const std::array<Dof, N>& dofs, const T& v
         }
     }
 }
+
+// Adds to an existing entry of the sparse matrix or inserts a new one if the entry isn't part of the sparsity pattern yet
+template<size_t N, class T>
+inline void add_by_dof(SparseMatrixXd* mat, const std::array<Dof, N>& dofs, const T& values) {
+    for(size_t i = 0; i < N; ++i) {
+        for(size_t j = 0; j < N; ++j) {
+            if(dofs[i].active && dofs[j].active) {
+                mat->coeffRef(dofs[i].index, dofs[j].index) += values(i, j);
+            }
+        }
+    }
+}
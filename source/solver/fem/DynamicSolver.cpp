@@ -1,15 +1,35 @@
 #include "DynamicSolver.hpp"
 #include "System.hpp"
-#include <Eigen/Eigenvalues>
+#include "Profiler.hpp"
+#include "solver/numerics/PowerIteration.hpp"
 
 DynamicSolver::DynamicSolver(System& system, double dt, double f_sample, const StopFn& stop)
     : system(system),
       stop(stop),
+      f_sample(f_sample),
+      factor(std::nullopt),
       dt(dt),
-      n(std::max(std::ceil(1.0/(f_sample*dt)), 1.0))
+      n(std::max(std::ceil(1.0/(f_sample*dt)), 1.0)),
+      M_inv(system.get_M().cwiseInverse())
 {
     // Initialise previous displacement
-    u_p2 = system.get_u() - dt*system.get_v() + dt*dt/2.0*system.get_a();
+    u_p = system.get_u() - dt*system.get_v() + dt*dt/2.0*system.get_a();
+}
+
+DynamicSolver::DynamicSolver(System& system, AdaptiveTimestep timestep, double f_sample, const StopFn& stop)
+    : system(system),
+      stop(stop),
+      f_sample(f_sample),
+      factor(timestep.factor),
+      M_inv(system.get_M().cwiseInverse()),
+      mode(VectorXd::NullaryExpr(system.dofs(), [](Eigen::Index i){ return std::sin(i + 1.0); }))
+{
+    // Choose the number of substeps such that they evenly divide the output step
+    n = std::max(std::ceil(1.0/(f_sample*estimate_timestep(system, M_inv, mode, *factor))), 1.0);
+    dt = 1.0/(f_sample*n);
+
+    // Initialise previous displacement
+    u_p = system.get_u() - dt*system.get_v() + dt*dt/2.0*system.get_a();
 }
 
 // Estimate timestep based on maximum eigen frequency and a safety factor to account for nonlinearity of the system
@@ -24,15 +44,41 @@ double DynamicSolver::estimate_timestep(const System& system, double factor) {
     return factor*2.0/mode.omega*(std::sqrt(1 + mode.zeta*mode.zeta) - mode.zeta);
     */
 
-    // Ignore damping and use selfadjoint solver, which is more efficient and can handle larger matrices
-    Eigen::GeneralizedSelfAdjointEigenSolver<MatrixXd>
-            eigen_solver(system.get_K(), system.get_M().asDiagonal(), Eigen::DecompositionOptions::EigenvaluesOnly);
+    VectorXd M_inv = system.get_M().cwiseInverse();
+    VectorXd mode = VectorXd::NullaryExpr(system.dofs(), [](Eigen::Index i){ return std::sin(i + 1.0); });
 
-    if(eigen_solver.info() != Eigen::Success) {
-        throw std::runtime_error("Failed to compute eigenvalues of the system");
+    return estimate_timestep(system, M_inv, mode, factor);
+}
+
+// Ignores damping and estimates the highest eigenvalue omega_max^2 of M^-1*K by power iteration on the symmetric matrix M^-1/2*K*M^-1/2,
+// which only needs sparse matrix-vector products. The argument mode is the starting vector and receives the resulting mode.
+// The Rayleigh quotient is a lower bound of the highest eigenvalue, so the residual is added as a margin for the remaining error.
+// The estimate is limited by the Gershgorin bound of the matrix, which is used instead if the iteration doesn't converge.
+double DynamicSolver::estimate_timestep(const System& system, const VectorXd& M_inv, VectorXd& mode, double factor) {
+    PROFILE_SCOPE("estimate_timestep");
+
+    const SparseMatrixXd& K = system.get_K();
+    VectorXd M_inv_sqrt = M_inv.cwiseSqrt();
+    VectorXd temp(K.rows());
+
+    PowerIterationResult result = power_iteration([&](const VectorXd& x, VectorXd& y) {
+        temp = M_inv_sqrt.cwiseProduct(x);
+        y.noalias() = K*temp;
+        y.array() *= M_inv_sqrt.array();
+    }, mode, 1e-3, 1000);    // Todo: Magic numbers
+
+    // Gershgorin bound: Largest absolute row sum of M^-1/2*K*M^-1/2 (K is symmetric, so the column sums are used)
+    double lambda_bound = 0.0;
+    for(int j = 0; j < K.outerSize(); ++j) {
+        double sum = 0.0;
+        for(SparseMatrixXd::InnerIterator it(K, j); it; ++it) {
+            sum += std::abs(it.value())*M_inv_sqrt[it.row()];
+        }
+        lambda_bound = std::max(lambda_bound, sum*M_inv_sqrt[j]);
     }
 
-    double omega_max = std::sqrt(eigen_solver.eigenvalues().maxCoeff());
+    double lambda_max = result.converged ? std::min(std::abs(result.lambda) + result.residual, lambda_bound) : lambda_bound;
+    double omega_max = std::sqrt(lambda_max);
     if(omega_max == 0.0) {
         throw std::runtime_error("Can't estimate timestep for system with a zero eigenvalue");
     }
@@ -40,23 +86,62 @@ double DynamicSolver::estimate_timestep(const System& system, double factor) {
     return factor*2.0/omega_max;
 }
 
+double DynamicSolver::get_timestep() const {
+    return dt;
+}
+
+// Re-estimates the critical timestep and changes the number of substeps per output step if necessary.
+// The timestep is decreased without limit, but only increased by max_growth per output step.
+// After a change of timestep the previous displacement is initialised from the current velocity and acceleration, like at the start.
+void DynamicSolver::adapt_timestep() {
+    double dt_next = std::min(estimate_timestep(system, M_inv, mode, *factor), max_growth*dt);
+    unsigned n_next = std::max(std::ceil(1.0/(f_sample*dt_next)), 1.0);
+
+    if(n_next != n) {
+        n = n_next;
+        dt = 1.0/(f_sample*n);
+        u_p = system.get_u() - dt*system.get_v() + dt*dt/2.0*system.get_a();
+    }
+}
+
 bool DynamicSolver::step() {
+    PROFILE_SCOPE("dynamic_solver");
+
+    if(factor) {
+        adapt_timestep();
+    }
+
     for(unsigned i = 0; i < n; ++i) {
         sub_step();
         if(stop()) {
+            PROFILE_COUNT("substeps", i + 1);
             return false;
         }
     }
 
+    PROFILE_COUNT("substeps", n);
     return true;
 }
 
+// Updates displacements and velocities in place with a single pass over the dofs.
+// The operations are the same as in u_next = 2*u - u_p + dt^2*M^-1*(p - q), v = (1.5*u_next - 2*u + 0.5*u_p)/dt,
+// evaluated in the same order, so the results are identical to an implementation based on vector expressions.
 void DynamicSolver::sub_step() {
-    u_p1 = system.get_u();
+    const VectorXd& p = system.get_p();
+    const VectorXd& q = system.get_q();    // Evaluates all elements before u and v are modified
 
-    system.set_u(2.0*system.get_u() - u_p2 + dt*dt*system.get_a());
-    system.set_v((1.5*system.get_u() - 2.0*u_p1 + 0.5*u_p2)/dt);
-    system.set_t(system.get_t() + dt);
+    VectorXd& u = system.mut_u();
+    VectorXd& v = system.mut_v();
+
+    double dt2 = dt*dt;
+    for(Eigen::Index i = 0; i < u.size(); ++i) {
+        double a_i = M_inv[i]*(p[i] - q[i]);
+        double u_i = 2.0*u[i] - u_p[i] + dt2*a_i;
 
-    u_p2 = u_p1;
+        v[i] = (1.5*u_i - 2.0*u[i] + 0.5*u_p[i])/dt;
+        u_p[i] = u[i];
+        u[i] = u_i;
+    }
+
+    system.set_t(system.get_t() + dt);
 }
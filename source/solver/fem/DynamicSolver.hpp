@@ -1,28 +1,50 @@
 #pragma once
 #include "solver/numerics/EigenTypes.hpp"
 #include <functional>
+#include <optional>
 
 class System;
 
 // Central difference method
+// The masses of the system are lumped and therefore the inverse mass matrix is diagonal.
+// It is computed once at construction, so the dofs and masses of the system must not change afterwards.
+//
+// The timestep is either fixed or adapted to the system at the beginning of each output step.
+// The adaptive timestep is a fraction of the critical timestep 2/omega_max of the undamped system,
+// where the highest natural frequency omega_max is estimated from the current tangent stiffness.
+// It therefore follows the changes in stiffness due to string tension and contact during the simulation.
 class DynamicSolver
 {
 public:
     using StopFn = std::function<bool()>;
 
+    struct AdaptiveTimestep {
+        double factor;    // Fraction of the critical timestep
+    };
+
     DynamicSolver(System& system, double dt, double f_sample, const StopFn& stop);
+    DynamicSolver(System& system, AdaptiveTimestep timestep, double f_sample, const StopFn& stop);
     static double estimate_timestep(const System& system, double factor);
+    double get_timestep() const;
     bool step();
 
 private:
     System& system;
     StopFn stop;
 
+    double f_sample;                 // Sampling rate of the output steps
+    std::optional<double> factor;    // Timestep factor if adaptive
+
     double dt;     // Substep size
     unsigned n;    // Number of substeps per step
 
-    VectorXd u_p2;
-    VectorXd u_p1;
+    VectorXd M_inv;    // Inverse of the diagonal mass matrix
+    VectorXd u_p;      // Displacements of the previous substep
+    VectorXd mode;     // Estimate of the highest mode, used as starting point for the next estimation
+
+    const double max_growth = 1.2;    // Maximum relative increase of the adaptive timestep per output step // Todo: Magic number
 
+    static double estimate_timestep(const System& system, const VectorXd& M_inv, VectorXd& mode, double factor);
+    void adapt_timestep();
     void sub_step();
 };
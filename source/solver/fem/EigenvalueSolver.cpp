@@ -1,7 +1,7 @@
 #include "EigenvalueSolver.hpp"
 #include "solver/fem/System.hpp"
-#include <algorithm>
-#include <optional>
+#include "solver/numerics/Arnoldi.hpp"
+#include "solver/numerics/PowerIteration.hpp"
 
 ModeInfo::ModeInfo(std::complex<double> lambda) {
     omega = std::hypot(lambda.real(), lambda.imag());
@@ -14,61 +14,89 @@ EigenvalueSolver::EigenvalueSolver(const System& system)
 
 }
 
-auto EigenvalueSolver::compute_eigenvalues() {
-    int n = system.dofs();
-    A.conservativeResize(2*n, 2*n);
-    B.conservativeResize(2*n, 2*n);
-
-    A << MatrixXd::Zero(n, n), system.get_K(),
-         system.get_K(), system.get_D();
-
-    B << system.get_K(), MatrixXd::Zero(n, n),
-         MatrixXd::Zero(n, n), -system.get_M().asDiagonal().toDenseMatrix();
-
-    solver.compute(A, B, Eigen::DecompositionOptions::EigenvaluesOnly);
-    if(solver.info() != Eigen::Success) {
-        throw std::runtime_error("Failed to compute eigenvalues of the system. Solver info: " + std::to_string(solver.info()));
+// Initializes the starting vector if it doesn't exist yet or if its size has changed
+void EigenvalueSolver::init_mode(VectorXd& z, size_t n) const {
+    if(z.size() != n) {
+        z = VectorXd::NullaryExpr(n, [](Eigen::Index i){ return std::sin(i + 1.0); });
     }
-
-    return solver.eigenvalues();
 }
 
-// Todo: Implement with filter + minimum
+// Shift-invert Arnoldi iteration with shift zero: The eigenvalues of C^-1 are mu = 1/lambda and the ones with the largest magnitude converge first.
+// Only the eigenvalues with positive imaginary part of lambda, i.e. negative imaginary part of mu, are considered.
 ModeInfo EigenvalueSolver::compute_minimum_frequency() {
-    std::optional<ModeInfo> result = std::nullopt;
-    auto eigenvalues = compute_eigenvalues();
-    for(int i = 0; i < eigenvalues.size(); ++i) {
-        if(eigenvalues[i].imag() > 0.0) {
-            ModeInfo temp(eigenvalues[i]);
-            if(!result || temp.omega < result->omega) {
-                result = temp;
-            }
-        }
-    }
+    const SparseMatrixXd& K = system.get_K();
+    const SparseMatrixXd& D = system.get_D();
+    const VectorXd& M = system.get_M();
+    size_t n = system.dofs();
 
-    if(!result) {
-        throw std::runtime_error("Failed to find eigenvalue with lowest natural frequency");
+    decomp.compute(K);
+    if(decomp.info() != Eigen::Success) {
+        throw std::runtime_error("Failed to find eigenvalue with lowest natural frequency: Decomposition of the stiffness matrix failed");
     }
 
-    return *result;
+    auto C_inv = [&](const Ref<const VectorXd>& x, VectorXd& y) {
+        y.head(n) = -decomp.solve(D*x.head(n) + M.cwiseProduct(x.tail(n)));
+        y.tail(n) = x.head(n);
+    };
+
+    auto score = [](std::complex<double> mu) {
+        return (mu.imag() < 0.0) ? std::abs(mu) : -1.0;
+    };
+
+    init_mode(z_min, 2*n);
+    std::complex<double> mu = arnoldi_iteration(C_inv, score, z_min, krylov_dim, rtol, restarts);
+
+    return ModeInfo(1.0/mu);
 }
 
-// Todo: Implement with filter + maximum
+// Arnoldi iteration on C: The eigenvalues with the largest magnitude converge first.
+// Only the eigenvalues with positive imaginary part are considered.
 ModeInfo EigenvalueSolver::compute_maximum_frequency() {
-    std::optional<ModeInfo> result = std::nullopt;
-    auto eigenvalues = compute_eigenvalues();
-    for(int i = 0; i < eigenvalues.size(); ++i) {
-        if(eigenvalues[i].imag() > 0.0) {
-            ModeInfo temp(eigenvalues[i]);
-            if(!result || temp.omega > result->omega) {
-                result = temp;
-            }
-        }
+    const SparseMatrixXd& K = system.get_K();
+    const SparseMatrixXd& D = system.get_D();
+    VectorXd M_inv = system.get_M().cwiseInverse();
+    size_t n = system.dofs();
+
+    auto C = [&](const Ref<const VectorXd>& x, VectorXd& y) {
+        y.head(n) = x.tail(n);
+        y.tail(n) = -M_inv.cwiseProduct(K*x.head(n) + D*x.tail(n));
+    };
+
+    auto score = [](std::complex<double> lambda) {
+        return (lambda.imag() > 0.0) ? std::abs(lambda) : -1.0;
+    };
+
+    init_mode(z_max, 2*n);
+    std::complex<double> lambda = arnoldi_iteration(C, score, z_max, krylov_dim, rtol, restarts);
+
+    return ModeInfo(lambda);
+}
+
+// Inverse power iteration on the symmetric matrix M^1/2*K^-1*M^1/2, whose largest eigenvalue is 1/omega_min^2 with eigenvector y = M^1/2*phi.
+// Damping is ignored.
+ModeShape EigenvalueSolver::compute_minimum_undamped_mode() {
+    const SparseMatrixXd& K = system.get_K();
+    VectorXd M_sqrt = system.get_M().cwiseSqrt();
+
+    decomp.compute(K);
+    if(decomp.info() != Eigen::Success) {
+        throw std::runtime_error("Failed to find lowest undamped mode: Decomposition of the stiffness matrix failed");
+    }
+
+    auto K_inv = [&](const VectorXd& x, VectorXd& y) {
+        y = M_sqrt.cwiseProduct(decomp.solve(M_sqrt.cwiseProduct(x)));
+    };
+
+    init_mode(y_min, system.dofs());
+    PowerIterationResult result = power_iteration(K_inv, y_min, rtol, 1000);    // Todo: Magic number
+    if(!result.converged) {
+        throw std::runtime_error("Failed to find lowest undamped mode: Maximum number of iterations exceeded");
     }
 
-    if(!result) {
-        throw std::runtime_error("Failed to find eigenvalue with highest natural frequency");
+    double mu = result.lambda;
+    if(mu <= 0.0) {
+        throw std::runtime_error("Failed to find lowest undamped mode: Stiffness matrix is not positive definite");
     }
 
-    return *result;
+    return { 1.0/std::sqrt(mu), y_min.cwiseQuotient(M_sqrt) };
 }
@@ -1,6 +1,6 @@
 #pragma once
 #include "solver/numerics/EigenTypes.hpp"
-#include <Eigen/Eigenvalues>
+#include <Eigen/SparseCholesky>
 #include <complex>
 
 class System;
@@ -16,17 +16,35 @@ struct ModeInfo {
     ModeInfo(std::complex<double> lambda);
 };
 
+// Natural frequency and mode shape of the undamped system, normalized such that phi^T*M*phi = 1
+struct ModeShape {
+    double omega;
+    VectorXd phi;
+};
+
+// Computes the extreme modes of the damped system, i.e. the solutions of (lambda^2*M + lambda*D + K)*x = 0.
+// The problem is linearized as z = [x, lambda*x] and C*z = lambda*z with C = [0, I; -M^-1*K, -M^-1*D],
+// but the matrix C is never formed. Instead the eigenvalues are found by Arnoldi iteration, which only needs products with C
+// (highest frequency) or, for the lowest frequency, with its inverse C^-1 = [-K^-1*D, -K^-1*M; I, 0] (shift-invert).
+// The latter requires a sparse factorization of K, which therefore has to be regular.
+// The modes of the previous calls are used as starting vectors, which speeds up repeated calls for similar systems.
 class EigenvalueSolver {
 public:
     EigenvalueSolver(const System& system);
     ModeInfo compute_minimum_frequency();
     ModeInfo compute_maximum_frequency();
+    ModeShape compute_minimum_undamped_mode();
 
 private:
     const System& system;
-    Eigen::GeneralizedEigenSolver<MatrixXd> solver;
-    MatrixXd A;
-    MatrixXd B;
+    Eigen::SimplicialLDLT<SparseMatrixXd> decomp;
+    VectorXd z_min;    // Estimate of the lowest mode
+    VectorXd z_max;    // Estimate of the highest mode
+    VectorXd y_min;    // Estimate of the lowest undamped mode
+
+    const unsigned krylov_dim = 30;    // Todo: Magic number
+    const unsigned restarts = 20;      // Todo: Magic number
+    const double rtol = 1e-10;         // Todo: Magic number
 
-    auto compute_eigenvalues();
+    void init_mode(VectorXd& z, size_t n) const;
 };
@@ -2,129 +2,218 @@
 #include "Element.hpp"
 #include <boost/range/iterator_range.hpp>
 #include <boost/iterator/transform_iterator.hpp>
+#include <memory>
 #include <vector>
 #include <map>
 
-// Transform iterator that performs a dynamic cast for every element. Adapted from stackoverflow,
-// http://stackoverflow.com/questions/842387/how-do-i-dynamically-cast-between-vectors-of-pointers/842491#842491
+// Stores the elements of one type contiguously and performs the element operations in batched loops.
+// The calls are qualified with the element type, which resolves them statically instead of by virtual dispatch.
 
-template<class Target>
-struct dynamic_caster {
-    using result_type = Target&;
+class ElementPoolBase {
+public:
+    virtual ~ElementPoolBase() = default;
+
+    virtual void add_masses() const = 0;
+    virtual void add_internal_forces() const = 0;
+    virtual void add_tangent_stiffness() const = 0;
+    virtual void add_tangent_damping() const = 0;
+
+    virtual double get_potential_energy(const std::vector<size_t>& indices) const = 0;
+    virtual double get_kinetic_energy(const std::vector<size_t>& indices) const = 0;
+};
+
+template<class ElementType>
+class ElementPool: public ElementPoolBase {
+public:
+    std::vector<ElementType> elements;
 
-    template<typename Source>
-    result_type& operator()(Source* s) const {
-         return dynamic_cast<result_type&>(*s);
+    void add_masses() const override {
+        for(const ElementType& element: elements)
+            element.ElementType::add_masses();
+    }
+
+    void add_internal_forces() const override {
+        for(const ElementType& element: elements)
+            element.ElementType::add_internal_forces();
+    }
+
+    void add_tangent_stiffness() const override {
+        for(const ElementType& element: elements)
+            element.ElementType::add_tangent_stiffness();
+    }
+
+    void add_tangent_damping() const override {
+        for(const ElementType& element: elements)
+            element.ElementType::add_tangent_damping();
+    }
+
+    double get_potential_energy(const std::vector<size_t>& indices) const override {
+        double e_pot = 0.0;
+        for(size_t i: indices)
+            e_pot += elements[i].ElementType::get_potential_energy();
+
+        return e_pot;
+    }
+
+    double get_kinetic_energy(const std::vector<size_t>& indices) const override {
+        double e_kin = 0.0;
+        for(size_t i: indices)
+            e_kin += elements[i].ElementType::get_kinetic_energy();
+
+        return e_kin;
     }
 };
 
-template<class Iterator, class Target>
-using dynamic_cast_iterator_base = boost::transform_iterator<dynamic_caster<Target>, Iterator>;
+// Maps element indices to the elements of a pool
+template<class ElementType>
+struct element_accessor {
+    using result_type = ElementType&;
 
-template<class Iterator, class Target>
-class dynamic_cast_iterator: public dynamic_cast_iterator_base<Iterator, Target> {
-public:
-    dynamic_cast_iterator(Iterator it)
-        : dynamic_cast_iterator_base<Iterator, Target>(it, dynamic_caster<Target>())
-    {
+    ElementType* data;
 
+    result_type operator()(size_t index) const {
+        return data[index];
     }
 };
 
-// The element container stores groups of elements that are identified by keys (string)
+// The element container stores groups of elements that are identified by keys (string).
+// Internally the elements are stored in pools by type, in the order of their addition, and a group holds the indices
+// of its elements in the respective pools. The assembly of the system quantities loops over the pools, i.e. by element type.
+// Adding an element invalidates references to other elements of the same type.
 
 class ElementContainer {
 public:
-    template<typename ElementType = Element>
+    template<typename ElementType>
     void add(ElementType element, const std::string& key = "") {
-        Element* ptr = new ElementType(element);
-        groups[key].push_back(ptr);
-        elements.push_back(ptr);
-    }
-
-    ~ElementContainer() {
-        for(Element* e: elements) {
-            delete e;
+        ElementPool<ElementType>* pool = find_pool<ElementType>();
+        if(pool == nullptr) {
+            pools.push_back(std::make_unique<ElementPool<ElementType>>());
+            pool = static_cast<ElementPool<ElementType>*>(pools.back().get());
         }
+
+        find_indices(key, pool).push_back(pool->elements.size());
+        pool->elements.push_back(element);
     }
 
     template<class ElementType>
-    using iterator = dynamic_cast_iterator<std::vector<Element*>::iterator, ElementType>;
+    using iterator = boost::transform_iterator<element_accessor<ElementType>, std::vector<size_t>::const_iterator>;
 
     template<class ElementType>
-    using const_iterator = dynamic_cast_iterator<std::vector<Element*>::const_iterator, ElementType>;
+    using const_iterator = iterator<const ElementType>;
 
-    // Iterating over all elements
+    // Assembly over all elements
 
-    iterator<Element> begin() {
-        return {elements.begin()};
+    void add_masses() const {
+        for(auto& pool: pools)
+            pool->add_masses();
     }
 
-    const_iterator<Element> begin() const {
-        return {elements.begin()};
+    void add_internal_forces() const {
+        for(auto& pool: pools)
+            pool->add_internal_forces();
     }
 
-    iterator<Element> end() {
-        return {elements.end()};
+    void add_tangent_stiffness() const {
+        for(auto& pool: pools)
+            pool->add_tangent_stiffness();
     }
 
-    const_iterator<Element> end() const {
-        return {elements.end()};
+    void add_tangent_damping() const {
+        for(auto& pool: pools)
+            pool->add_tangent_damping();
     }
 
-    // Iterating over groups of elements
+    // Iterating over the elements of a group that have the given type
 
     template<class ElementType>
     boost::iterator_range<iterator<ElementType>> group(const std::string& key) {
-        return {groups[key].begin(), groups[key].end()};
+        return make_range<ElementType>(find_pool<ElementType>(), key);
     }
 
     template<class ElementType>
     boost::iterator_range<const_iterator<ElementType>> group(const std::string& key) const {
-        return {groups[key].begin(), groups[key].end()};
+        return make_range<const ElementType>(find_pool<ElementType>(), key);
     }
 
     // Single element access
 
     template<class ElementType>
     ElementType& front(const std::string& key) {
-        return dynamic_cast<ElementType&>(*groups[key].front());
+        return group<ElementType>(key).front();
     }
 
     template<class ElementType>
     const ElementType& front(const std::string& key) const {
-        return dynamic_cast<const ElementType&>(*groups[key].front());
+        return group<ElementType>(key).front();
     }
 
     template<class ElementType>
     ElementType& back(const std::string& key) {
-        return dynamic_cast<ElementType&>(*groups[key].back());
+        return group<ElementType>(key).back();
     }
 
     template<class ElementType>
     const ElementType& back(const std::string& key) const {
-        return dynamic_cast<const ElementType&>(*groups[key].back());
+        return group<ElementType>(key).back();
     }
 
     // Summing energies of groups
 
     double get_kinetic_energy(const std::string& key) const {
         double e_kin = 0.0;
-        for(auto e: groups[key])
-            e_kin += e->get_kinetic_energy();
+        for(auto& entry: groups[key])
+            e_kin += entry.first->get_kinetic_energy(entry.second);
 
         return e_kin;
     }
 
     double get_potential_energy(const std::string& key) const {
         double e_pot = 0.0;
-        for(auto e: groups[key])
-            e_pot += e->get_potential_energy();
+        for(auto& entry: groups[key])
+            e_pot += entry.first->get_potential_energy(entry.second);
 
         return e_pot;
     }
 
 private:
-    mutable std::vector<Element*> elements;
-    mutable std::map<std::string, std::vector<Element*>> groups;
+    using Group = std::vector<std::pair<const ElementPoolBase*, std::vector<size_t>>>;    // Element indices per pool
+
+    std::vector<std::unique_ptr<ElementPoolBase>> pools;
+    mutable std::map<std::string, Group> groups;
+
+    template<class ElementType>
+    ElementPool<ElementType>* find_pool() const {
+        for(auto& pool: pools) {
+            if(auto result = dynamic_cast<ElementPool<ElementType>*>(pool.get())) {
+                return result;
+            }
+        }
+
+        return nullptr;
+    }
+
+    std::vector<size_t>& find_indices(const std::string& key, const ElementPoolBase* pool) const {
+        Group& group = groups[key];
+        for(auto& entry: group) {
+            if(entry.first == pool) {
+                return entry.second;
+            }
+        }
+
+        group.push_back({pool, {}});
+        return group.back().second;
+    }
+
+    template<class ElementType, class PoolType>
+    boost::iterator_range<iterator<ElementType>> make_range(PoolType* pool, const std::string& key) const {
+        static const std::vector<size_t> none;
+        if(pool == nullptr) {
+            return {iterator<ElementType>(none.begin(), {nullptr}), iterator<ElementType>(none.end(), {nullptr})};
+        }
+
+        const std::vector<size_t>& indices = find_indices(key, pool);
+        element_accessor<ElementType> accessor{pool->elements.data()};
+
+        return {iterator<ElementType>(indices.begin(), accessor), iterator<ElementType>(indices.end(), accessor)};
+    }
 };
@@ -0,0 +1,67 @@
+#include "Profiler.hpp"
+#include <nlohmann/json.hpp>
+
+static thread_local Profiler* active_profiler = nullptr;
+
+Profiler::Activation::Activation(Profiler& profiler)
+    : previous(active_profiler)
+{
+    active_profiler = &profiler;
+}
+
+Profiler::Activation::~Activation() {
+    active_profiler = previous;
+}
+
+Profiler* Profiler::active() {
+    return active_profiler;
+}
+
+void Profiler::enter(const char* name) {
+    paths.push_back(paths.empty() ? std::string(name) : paths.back() + "/" + name);
+}
+
+void Profiler::leave(double time) {
+    Timer& timer = timers[paths.back()];
+    timer.time += time;
+    timer.calls += 1;
+    paths.pop_back();
+}
+
+void Profiler::count(const char* name, unsigned long n) {
+    counters[paths.empty() ? std::string(name) : paths.back() + "/" + name] += n;
+}
+
+const std::map<std::string, Profiler::Timer>& Profiler::get_timers() const {
+    return timers;
+}
+
+const std::map<std::string, unsigned long>& Profiler::get_counters() const {
+    return counters;
+}
+
+void to_json(nlohmann::json& obj, const Profiler::Timer& timer) {
+    obj["time"] = timer.time;
+    obj["calls"] = timer.calls;
+}
+
+void to_json(nlohmann::json& obj, const Profiler& profiler) {
+    obj["timers"] = profiler.get_timers();
+    obj["counters"] = profiler.get_counters();
+}
+
+ProfileScope::ProfileScope(const char* name)
+    : profiler(Profiler::active())
+{
+    if(profiler != nullptr) {
+        profiler->enter(name);
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+ProfileScope::~ProfileScope() {
+    if(profiler != nullptr) {
+        std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+        profiler->leave(time.count());
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <nlohmann/json_fwd.hpp>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <map>
+
+// Collects the run times of nested scopes and the values of counters during a simulation.
+// A profiler is made active for the current thread by an Activation and is then filled by the PROFILE_SCOPE and PROFILE_COUNT macros.
+// Timers and counters are identified by the path of their enclosing scopes, e.g. "setup/limb/damping".
+// Without an active profiler the macros only cost a check of a thread local pointer.
+// If VIRTUALBOW_PROFILING isn't defined, they are removed entirely.
+class Profiler
+{
+public:
+    struct Timer {
+        double time = 0.0;          // Total time in seconds
+        unsigned long calls = 0;    // Number of times the scope was entered
+    };
+
+    // Makes the profiler the active one of the current thread during its lifetime
+    class Activation {
+    public:
+        Activation(Profiler& profiler);
+        ~Activation();
+
+    private:
+        Profiler* previous;
+    };
+
+    static Profiler* active();
+
+    void enter(const char* name);
+    void leave(double time);
+    void count(const char* name, unsigned long n);
+
+    const std::map<std::string, Timer>& get_timers() const;
+    const std::map<std::string, unsigned long>& get_counters() const;
+
+private:
+    std::vector<std::string> paths;    // Paths of the currently entered scopes
+    std::map<std::string, Timer> timers;
+    std::map<std::string, unsigned long> counters;
+};
+
+void to_json(nlohmann::json& obj, const Profiler::Timer& timer);
+void to_json(nlohmann::json& obj, const Profiler& profiler);
+
+// Measures the time from construction to destruction with the active profiler, if any
+class ProfileScope
+{
+public:
+    ProfileScope(const char* name);
+    ~ProfileScope();
+
+private:
+    Profiler* profiler;
+    std::chrono::steady_clock::time_point start;
+};
+
+#ifdef VIRTUALBOW_PROFILING
+    #define PROFILE_CONCAT_IMPL(a, b) a##b
+    #define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+    #define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+    #define PROFILE_COUNT(name, n) do { if(Profiler* profiler = Profiler::active()) { profiler->count(name, n); } } while(false)
+#else
+    #define PROFILE_SCOPE(name) do {} while(false)
+    #define PROFILE_COUNT(name, n) do { (void) sizeof(n); } while(false)    // Not evaluated, but avoids warnings about unused variables
+#endif
@@ -1,9 +1,14 @@
 #include "StaticSolver.hpp"
 #include "solver/fem/System.hpp"
+#include "solver/fem/Profiler.hpp"
 #include "solver/numerics/Optimization.hpp"
+#include <limits>
 
-StaticSolver::StaticSolver(System& system)
+StaticSolver::StaticSolver(System& system, Strategy strategy)
     : system(system),
+      strategy(strategy),
+      pattern_nnz(-1),
+      age(0),
       delta_q(system.dofs()),
       delta_u(system.dofs()),
       alpha(system.dofs()),
@@ -14,15 +19,30 @@ StaticSolver::StaticSolver(System& system)
 }
 
 StaticSolver::Info StaticSolver::solve() {
+    PROFILE_SCOPE("static_solver");
+    PROFILE_COUNT("evaluations", 1);
+
+    Info info = {Info::NoConvergence, 0, 0, 1};    // Residual of the initial state
+    double residual_prev = std::numeric_limits<double>::infinity();
     double lambda = 1.0;
-    for(unsigned i = 0; i < max_iter; ++i) {
-        decomp.compute(system.get_K());
-        if(decomp.info() != Eigen::Success)
-            return {Info::DecompFailed, i+1};
+
+    for(unsigned i = 0; i < strategy.max_iter; ++i) {
+        info.iterations = i+1;
+        PROFILE_COUNT("iterations", 1);
+
+        if(needs_factorization()) {
+            info.factorizations += 1;
+            PROFILE_COUNT("factorizations", 1);
+            if(!factorize()) {
+                info.outcome = Info::DecompFailed;
+                return info;
+            }
+        }
+        age += 1;
 
         delta_q = system.get_q() - lambda*system.get_p();
-        alpha = -decomp.solve(delta_q);
-        beta = decomp.solve(system.get_p());
+        alpha = -solve_linear(delta_q);
+        beta = solve_linear(system.get_p());
 
         // Evaluate constraint
         constraint(system.get_u(), lambda, c, dcdl, dcdu);
@@ -38,28 +58,112 @@ StaticSolver::Info StaticSolver::solve() {
 
         // Line search
         VectorXd u_start = system.get_u();
+        VectorXd q_start = system.get_q();
         double l_start = lambda;
         auto f = [&](double eta) {
+            info.evaluations += 1;
+            PROFILE_COUNT("evaluations", 1);
             system.set_u(u_start + eta*delta_u);
             lambda = l_start + eta*delta_l;
             return std::abs(delta_u.transpose()*(system.get_q() - lambda*system.get_p()));
         };
 
-        golden_section_search(f, 0.0, 1.0, 1e-2, 50);
+        if(strategy.line_search == Strategy::Backtracking) {
+            backtracking_golden_section_search(f, std::abs(delta_u.transpose()*delta_q), armijo_c, 0.5, max_backtracking, 1e-2, 50);
+        }
+        else {
+            golden_section_search(f, 0.0, 1.0, 1e-2, 50);
+        }
 
         // If convergence...
-        if(std::abs(delta_u.transpose()*delta_q) + std::abs(delta_l*c) < epsilon) {    // Todo: Better convergence criterion
+        double residual = std::abs(delta_u.transpose()*delta_q) + std::abs(delta_l*c);    // Todo: Better convergence criterion
+        if(residual < epsilon) {
             // ...apply load factor to the system and return
             system.set_p(lambda*system.get_p());
-            return {Info::Success, i+1};
+            info.outcome = Info::Success;
+            return info;
+        }
+
+        // Discard an old factorization if the iterations don't converge fast enough with it
+        if(residual > max_ratio*residual_prev) {
+            age = strategy.max_age;
         }
+        else if(strategy.type == Strategy::BFGS) {
+            add_update(system.get_u() - u_start, system.get_q() - q_start);
+        }
+
+        residual_prev = residual;
+    }
+
+    return info;
+}
+
+bool StaticSolver::needs_factorization() const {
+    if(strategy.type == Strategy::FullNewton) {
+        return true;
+    }
+
+    return age >= strategy.max_age || decomp.rows() != system.dofs();
+}
+
+// Decomposes the current stiffness matrix, returns false on failure
+bool StaticSolver::factorize() {
+    const SparseMatrixXd& K = system.get_K();
+
+    // The sparsity pattern of the system only ever grows, so comparing the number of nonzeros is sufficient to detect changes
+    if(K.nonZeros() != pattern_nnz) {
+        decomp.analyzePattern(K);
+        pattern_nnz = K.nonZeros();
+    }
+
+    decomp.factorize(K);
+    bool success = (decomp.info() == Eigen::Success);
+
+    age = success ? 0 : strategy.max_age;    // Don't reuse a failed factorization
+    bfgs_s.clear();
+    bfgs_y.clear();
+    bfgs_rho.clear();
+
+    return success;
+}
+
+// Stores a BFGS update for the displacement difference s and internal force difference y.
+// Updates that would violate the positive definiteness of the approximation are skipped.
+void StaticSolver::add_update(const VectorXd& s, const VectorXd& y) {
+    double sy = s.dot(y);
+    if(sy <= std::numeric_limits<double>::epsilon()*s.norm()*y.norm()) {
+        return;
+    }
+
+    bfgs_s.push_back(s);
+    bfgs_y.push_back(y);
+    bfgs_rho.push_back(1.0/sy);
+}
+
+// Solves K*x = rhs with the current approximation of the stiffness matrix.
+// The BFGS updates are applied to the factorized matrix with the two-loop recursion, see
+// https://en.wikipedia.org/wiki/Limited-memory_BFGS#Algorithm
+VectorXd StaticSolver::solve_linear(const VectorXd& rhs) const {
+    size_t k = bfgs_s.size();
+    std::vector<double> a(k);
+
+    VectorXd x = rhs;
+    for(size_t i = k; i-- > 0;) {
+        a[i] = bfgs_rho[i]*bfgs_s[i].dot(x);
+        x -= a[i]*bfgs_y[i];
+    }
+
+    x = decomp.solve(x);
+    for(size_t i = 0; i < k; ++i) {
+        double b = bfgs_rho[i]*bfgs_y[i].dot(x);
+        x += (a[i] - b)*bfgs_s[i];
     }
 
-    return {Info::NoConvergence, max_iter};
+    return x;
 }
 
-StaticSolverLC::StaticSolverLC(System& system)
-    : StaticSolver(system)
+StaticSolverLC::StaticSolverLC(System& system, Strategy strategy)
+    : StaticSolver(system, strategy)
 {
 
 }
@@ -74,8 +178,8 @@ void StaticSolverLC::constraint(const VectorXd& u, double lambda, double& c, dou
     dcdu.setZero();
 }
 
-StaticSolverDC::StaticSolverDC(System& system, Dof dof)
-    : StaticSolver(system),
+StaticSolverDC::StaticSolverDC(System& system, Dof dof, Strategy strategy)
+    : StaticSolver(system, strategy),
       dof(dof),
       target(0.0),
       e_dof(VectorXd::Unit(system.dofs(), dof.index))
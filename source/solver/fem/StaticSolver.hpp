@@ -2,20 +2,46 @@
 #include "Node.hpp"
 #include "solver/numerics/Optimization.hpp"
 #include "solver/numerics/EigenTypes.hpp"
-#include <Eigen/Cholesky>
+#include <Eigen/SparseCholesky>
+#include <vector>
 
 class System;
 
 // Todo: Make constraint function a member with templated type instead of using inheritance.
 class StaticSolver {
 public:
+    // Determines how the stiffness matrix is updated between iterations
+    //
+    // FullNewton: Factorize the current stiffness matrix on every iteration
+    // ModifiedNewton: Keep a factorization for up to max_age iterations, also across calls of solve()
+    // BFGS: Like ModifiedNewton, but improve the inverse of the old stiffness matrix by BFGS rank-two updates [1]
+    //
+    // The old factorization is also discarded as soon as the iterations stop converging at a reasonable rate.
+    //
+    // The line search along each step minimizes the projection of the residual on the step direction.
+    //
+    // GoldenSection: Golden section search on the whole step, about 20 residual evaluations per iteration
+    // Backtracking: Accept the full step if the residual decreases sufficiently, otherwise halve it a few times.
+    //               Falls back to the golden section search if no acceptable step is found.
+    //
+    // [1] H. Matthies, G. Strang. The solution of nonlinear finite element equations.
+    //     International Journal for Numerical Methods in Engineering 14 (1979) 1613-1626
+    struct Strategy {
+        enum { FullNewton, ModifiedNewton, BFGS } type = FullNewton;
+        unsigned max_age = 10;    // Maximum number of iterations per factorization
+        enum { GoldenSection, Backtracking } line_search = Backtracking;
+        unsigned max_iter = 150;    // Maximum number of iterations per call of solve() // Todo: Magic number
+    };
+
     // Todo: State for failed line search
     struct Info {
         enum { Success, DecompFailed, NoConvergence } outcome;
-        unsigned iterations;
+        unsigned iterations;        // Number of iterations
+        unsigned factorizations;    // Number of stiffness matrix factorizations
+        unsigned evaluations;       // Number of residual evaluations
     };
 
-    StaticSolver(System& system);
+    StaticSolver(System& system, Strategy strategy);
 
 protected:
     Info solve();
@@ -23,11 +49,24 @@ protected:
 
 private:
     System& system;
+    Strategy strategy;
 
-    const unsigned max_iter = 150;    // Todo: Magic number
     const double epsilon = 1e-5;      // Todo: Magic number
+    const double max_ratio = 0.5;     // Maximum ratio of two consecutive residuals before refactorizing // Todo: Magic number
+    const double armijo_c = 1e-4;     // Sufficient decrease parameter of the backtracking line search // Todo: Magic number
+    const unsigned max_backtracking = 5;    // Todo: Magic number
+
+    // Sparse LDLT decomposition of the stiffness matrix. The symbolic analysis (ordering, structure of the factors)
+    // is only redone if the sparsity pattern of the stiffness matrix changed since the last decomposition.
+    Eigen::SimplicialLDLT<SparseMatrixXd> decomp;
+    Eigen::Index pattern_nnz;
+    unsigned age;    // Number of iterations since the last factorization
+
+    // BFGS updates since the last factorization
+    std::vector<VectorXd> bfgs_s;    // Displacement differences
+    std::vector<VectorXd> bfgs_y;    // Internal force differences
+    std::vector<double> bfgs_rho;    // 1/(s^T*y)
 
-    Eigen::LDLT<MatrixXd> decomp;
     VectorXd delta_q;
     VectorXd delta_u;
     VectorXd alpha;
@@ -36,12 +75,17 @@ private:
     double c;
     double dcdl;
     VectorXd dcdu;
+
+    bool needs_factorization() const;
+    bool factorize();
+    void add_update(const VectorXd& s, const VectorXd& y);
+    VectorXd solve_linear(const VectorXd& rhs) const;
 };
 
 class StaticSolverLC: public StaticSolver
 {
 public:
-    StaticSolverLC(System& system);
+    StaticSolverLC(System& system, Strategy strategy = {});
     Info solve();
 
 protected:
@@ -51,7 +95,7 @@ protected:
 class StaticSolverDC: public StaticSolver
 {
 public:
-    StaticSolverDC(System& system, Dof dof);
+    StaticSolverDC(System& system, Dof dof, Strategy strategy = {});
     Info solve(double displacement);
 
 protected:
@@ -1,5 +1,16 @@
 #include "System.hpp"
 
+// Resizes a sparse matrix to n x n and sets all entries of its existing sparsity pattern to zero
+static void reset_sparse(SparseMatrixXd& matrix, size_t n)
+{
+    if(matrix.rows() != n || matrix.cols() != n) {
+        matrix.conservativeResize(n, n);
+        matrix.makeCompressed();
+    }
+
+    matrix.coeffs().setZero();
+}
+
 System::System()
     : t(0.0), n_a(0), n_f(0)
 {
@@ -15,8 +26,7 @@ System::System()
         q_a.mut().setZero();
         q_f.mut().setZero();
 
-        for(auto& e: elements.get())
-            e.add_internal_forces();
+        elements.get().add_internal_forces();
 
         q_a.set_valid(true);
         q_f.set_valid(true);
@@ -27,26 +37,28 @@ System::System()
         M_a.mut().conservativeResize(dofs());
         M_a.mut().setZero();
 
-        for(auto& e: elements.get())
-            e.add_masses();
+        elements.get().add_masses();
     };
 
+    // The sparsity patterns of K and D are created by the first assembly and kept afterwards,
+    // so that later assemblies only have to reset and accumulate the existing nonzero values.
+    // New entries are only inserted if an element couples previously unconnected dofs (e.g. a new contact).
     auto update_K = [&]()
     {
-        K_a.mut().conservativeResize(dofs(), dofs());
-        K_a.mut().setZero();
+        reset_sparse(K_a.mut(), dofs());
+
+        elements.get().add_tangent_stiffness();
 
-        for(auto& e: elements.get())
-            e.add_tangent_stiffness();
+        K_a.mut().makeCompressed();
     };
 
     auto update_D = [&]()
     {
-        D_a.mut().conservativeResize(dofs(), dofs());
-        D_a.mut().setZero();
+        reset_sparse(D_a.mut(), dofs());
 
-        for(auto& e: elements.get())
-            e.add_tangent_damping();
+        elements.get().add_tangent_damping();
+
+        D_a.mut().makeCompressed();
     };
 
     a_a.depends_on(M_a, p_a, q_a);
@@ -125,6 +137,27 @@ size_t System::dofs() const
     return n_a.get();
 }
 
+System::UpdateCounts System::get_update_counts() const
+{
+    return {
+        a_a.get_updates(),
+        q_a.get_updates() + q_f.get_updates(),    // Both are computed by the same update
+        M_a.get_updates(),
+        K_a.get_updates(),
+        D_a.get_updates()
+    };
+}
+
+IndependentBase::Version System::get_u_version() const
+{
+    return u_a.get_version() + u_f.get_version();
+}
+
+System::UpdateCounts System::UpdateCounts::operator-(const UpdateCounts& other) const
+{
+    return { a - other.a, q - other.q, M - other.M, K - other.K, D - other.D };
+}
+
 double System::get_t() const
 {
     return t;
@@ -165,12 +198,12 @@ const VectorXd& System::get_M() const
     return M_a.get();
 }
 
-const MatrixXd& System::get_K() const
+const SparseMatrixXd& System::get_K() const
 {
     return K_a.get();
 }
 
-const MatrixXd& System::get_D() const
+const SparseMatrixXd& System::get_D() const
 {
     return D_a.get();
 }
@@ -210,6 +243,16 @@ void System::set_v(const Ref<const VectorXd>& v)
     v_a.mut() = v;
 }
 
+VectorXd& System::mut_u()
+{
+    return u_a.mut();
+}
+
+VectorXd& System::mut_v()
+{
+    return v_a.mut();
+}
+
 void System::set_p(const Ref<const VectorXd>& p)
 {
     p_a.mut() = p;
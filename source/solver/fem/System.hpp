@@ -8,6 +8,18 @@
 
 class System
 {
+public:
+    // Number of recomputations of the dependent quantities, e.g. for comparing solver phases
+    struct UpdateCounts {
+        unsigned long a = 0;    // Accelerations
+        unsigned long q = 0;    // Internal forces
+        unsigned long M = 0;    // Masses
+        unsigned long K = 0;    // Tangent stiffness matrix
+        unsigned long D = 0;    // Tangent damping matrix
+
+        UpdateCounts operator-(const UpdateCounts& other) const;
+    };
+
 private:
     Independent<ElementContainer> elements;
 
@@ -23,8 +35,8 @@ private:
     mutable Dependent<VectorXd> q_a;    // Internal forces (active)
     mutable Dependent<VectorXd> q_f;    // Internal forces (fixed)
     mutable Dependent<VectorXd> M_a;    // Diagonal masses (active)
-    mutable Dependent<MatrixXd> K_a;    // Tangent stiffness matrix (active)
-    mutable Dependent<MatrixXd> D_a;    // Tangent damping matrix (active)
+    mutable Dependent<SparseMatrixXd> K_a;    // Tangent stiffness matrix (active)
+    mutable Dependent<SparseMatrixXd> D_a;    // Tangent damping matrix (active)
 
 public:
     System();
@@ -44,6 +56,8 @@ public:
     // System data
 
     size_t dofs() const;
+    UpdateCounts get_update_counts() const;
+    IndependentBase::Version get_u_version() const;    // Changes whenever the displacements are modified
 
     double get_t() const;
     void set_t(double t);
@@ -54,8 +68,8 @@ public:
     const VectorXd& get_a() const;
     const VectorXd& get_q() const;
     const VectorXd& get_M() const;
-    const MatrixXd& get_K() const;
-    const MatrixXd& get_D() const;
+    const SparseMatrixXd& get_K() const;
+    const SparseMatrixXd& get_D() const;
 
     double get_u(Dof dof) const;
     double get_v(Dof dof) const;
@@ -76,6 +90,8 @@ public:
 
     void set_u(const Ref<const VectorXd>& u);
     void set_v(const Ref<const VectorXd>& v);
+    VectorXd& mut_u();
+    VectorXd& mut_v();
     void set_p(const Ref<const VectorXd>& p);
     void set_p(Dof dof, double p);
 
@@ -1,6 +1,13 @@
 #include "BeamElement.hpp"
 #include "solver/fem/System.hpp"
 #include <cstdlib>
+#include <cmath>
+
+// Equivalent to atan(tan(x)) or atan(sin(x)/cos(x)), i.e. maps x to [-pi/2, pi/2] by subtracting a multiple of pi
+static double wrap_angle(double x)
+{
+    return x - M_PI*std::round(x/M_PI);
+}
 
 BeamElement::BeamElement(System& system, Node node0, Node node1, double rhoA, double L)
     : Element(system),
@@ -55,32 +62,98 @@ void BeamElement::add_masses() const
 
 void BeamElement::add_internal_forces() const
 {
-    Matrix<3, 6> J = get_J();
-    Vector<3> e = get_e();
+    double dx = system.get_u(dofs[3]) - system.get_u(dofs[0]);
+    double dy = system.get_u(dofs[4]) - system.get_u(dofs[1]);
     Vector<6> v = system.get_v(dofs);
 
-    system.add_q(dofs, J.transpose()*K*e + D*v);
+    // Damping matrix is diagonal, see set_damping
+    system.add_q(dofs, get_q(dx, dy, get_a(dx, dy), K*get_e()) + D.diagonal().cwiseProduct(v));
 }
 
 void BeamElement::add_tangent_stiffness() const
+{
+    double dx = system.get_u(dofs[3]) - system.get_u(dofs[0]);
+    double dy = system.get_u(dofs[4]) - system.get_u(dofs[1]);
+
+    system.add_K(dofs, get_K(dx, dy, get_a(dx, dy), K*get_e(), K));
+}
+
+void BeamElement::add_tangent_damping() const
+{
+    system.add_D(dofs, D);
+}
+
+double BeamElement::get_potential_energy() const
 {
     Vector<3> e = get_e();
-    Matrix<3, 6> J = get_J();
+    return 0.5*e.transpose()*K*e;
+}
+
+double BeamElement::get_kinetic_energy() const
+{
+    Vector<6> v = system.get_v(dofs);
+    return 0.5*v.transpose()*M.asDiagonal()*v;
+}
 
+Vector<3> BeamElement::get_e() const
+{
     double dx = system.get_u(dofs[3]) - system.get_u(dofs[0]);
     double dy = system.get_u(dofs[4]) - system.get_u(dofs[1]);
+    double phi = std::atan2(dy, dx);
 
-    double a0 = pow(dx*dx + dy*dy, -0.5);
+    // Elastic coordinates
+    return {
+        std::hypot(dx, dy) - L,
+        wrap_angle(system.get_u(dofs[2]) + phi_ref_0 - phi),
+        wrap_angle(system.get_u(dofs[5]) + phi_ref_1 - phi)
+    };
+}
+
+Vector<4> BeamElement::get_a(double dx, double dy)
+{
     double a1 = 1.0/(dx*dx + dy*dy);
-    double a2 = pow(dx*dx + dy*dy, -1.5);
-    double a3 = pow(dx*dx + dy*dy, -2.0);
+    double a0 = std::sqrt(a1);
 
-    double b0 = a2*dx*dx - a0;
-    double b1 = a2*dy*dy - a0;
-    double b2 = a2*dx*dy;
-    double b3 = 2.0*a3*dx*dx - a1;
-    double b4 = 2.0*a3*dy*dy - a1;
-    double b5 = 2.0*a3*dx*dy;
+    return {a0, a1, a0*a1, a1*a1};
+}
+
+// Elastic part of the internal forces, J^T*f evaluated in closed form
+Vector<6> BeamElement::get_q(double dx, double dy, const Vector<4>& a, const Vector<3>& f)
+{
+    double j0 = a(0)*dx;
+    double j1 = a(0)*dy;
+    double j2 = a(1)*dx;
+    double j3 = a(1)*dy;
+
+    return {
+        -j0*f(0) - j3*(f(1) + f(2)),
+        -j1*f(0) + j2*(f(1) + f(2)),
+         f(1),
+         j0*f(0) + j3*(f(1) + f(2)),
+         j1*f(0) - j2*(f(1) + f(2)),
+         f(2)
+    };
+}
+
+// Tangent stiffness matrix Kn + J^T*K*J, where Kn contains the derivatives of J
+Matrix<6, 6> BeamElement::get_K(double dx, double dy, const Vector<4>& a, const Vector<3>& f, const Matrix<3, 3>& K)
+{
+    double j0 = a(0)*dx;
+    double j1 = a(0)*dy;
+    double j2 = a(1)*dx;
+    double j3 = a(1)*dy;
+
+    Matrix<3, 6> J;
+    J << -j0, -j1, 0.0, j0,  j1, 0.0,
+         -j3,  j2, 1.0, j3, -j2, 0.0,
+         -j3,  j2, 0.0, j3, -j2, 1.0;
+
+    double b0 = a(2)*dx*dx - a(0);
+    double b1 = a(2)*dy*dy - a(0);
+    double b2 = a(2)*dx*dy;
+    double b3 = 2.0*a(3)*dx*dx - a(1);
+    double b4 = 2.0*a(3)*dy*dy - a(1);
+    double b5 = 2.0*a(3)*dx*dy;
 
     Matrix<3, 6> dJ0;
     dJ0 << -b0, -b2, 0.0, b0,  b2, 0.0,
@@ -93,64 +166,105 @@ void BeamElement::add_tangent_stiffness() const
            -b4,  b5, 0.0, b4, -b5, 0.0;
 
     Matrix<6, 6> Kn = Matrix<6, 6>::Zero();
-    Kn.col(0) =  dJ0.transpose()*K*e;
-    Kn.col(1) =  dJ1.transpose()*K*e;
-    Kn.col(3) = -dJ0.transpose()*K*e;
-    Kn.col(4) = -dJ1.transpose()*K*e;
+    Kn.col(0) =  dJ0.transpose()*f;
+    Kn.col(1) =  dJ1.transpose()*f;
+    Kn.col(3) = -dJ0.transpose()*f;
+    Kn.col(4) = -dJ1.transpose()*f;
 
-    system.add_K(dofs, Kn + J.transpose()*K*J);
+    return Kn + J.transpose()*K*J;
 }
 
-void BeamElement::add_tangent_damping() const
+void ElementPool<BeamElement>::add_masses() const
 {
-    system.add_D(dofs, D);
+    for(const BeamElement& element: elements)
+        element.add_masses();
 }
 
-double BeamElement::get_potential_energy() const
+void ElementPool<BeamElement>::add_internal_forces() const
 {
-    Vector<3> e = get_e();
-    return 0.5*e.transpose()*K*e;
+    update_kinematics();
+
+    for(size_t i = 0; i < elements.size(); ++i) {
+        const BeamElement& element = elements[i];
+        Vector<3> f = element.K*Vector<3>(e0[i], e1[i], e2[i]);
+        Vector<4> a(a0[i], a1[i], a2[i], a3[i]);
+
+        // Damping matrix is diagonal, see BeamElement::set_damping
+        Vector<6> v = element.system.get_v(element.dofs);
+        element.system.add_q(element.dofs, BeamElement::get_q(dx[i], dy[i], a, f) + element.D.diagonal().cwiseProduct(v));
+    }
 }
 
-double BeamElement::get_kinetic_energy() const
+void ElementPool<BeamElement>::add_tangent_stiffness() const
 {
-    Vector<6> v = system.get_v(dofs);
-    return 0.5*v.transpose()*M.asDiagonal()*v;
+    update_kinematics();
+
+    for(size_t i = 0; i < elements.size(); ++i) {
+        const BeamElement& element = elements[i];
+        Vector<3> f = element.K*Vector<3>(e0[i], e1[i], e2[i]);
+        Vector<4> a(a0[i], a1[i], a2[i], a3[i]);
+
+        element.system.add_K(element.dofs, BeamElement::get_K(dx[i], dy[i], a, f, element.K));
+    }
 }
 
-Vector<3> BeamElement::get_e() const
+void ElementPool<BeamElement>::add_tangent_damping() const
 {
-    double dx = system.get_u(dofs[3]) - system.get_u(dofs[0]);
-    double dy = system.get_u(dofs[4]) - system.get_u(dofs[1]);
-    double phi = std::atan2(dy, dx);
+    for(const BeamElement& element: elements)
+        element.add_tangent_damping();
+}
 
-    // Elastic coordinates
-    double sin_e1 = std::sin(system.get_u(dofs[2]) + phi_ref_0 - phi);
-    double cos_e1 = std::cos(system.get_u(dofs[2]) + phi_ref_0 - phi);
-    double sin_e2 = std::sin(system.get_u(dofs[5]) + phi_ref_1 - phi);
-    double cos_e2 = std::cos(system.get_u(dofs[5]) + phi_ref_1 - phi);
+double ElementPool<BeamElement>::get_potential_energy(const std::vector<size_t>& indices) const
+{
+    double e_pot = 0.0;
+    for(size_t i: indices)
+        e_pot += elements[i].get_potential_energy();
 
-    // Todo: Replace atan(sin(x)/cos(x)) with a cheaper function
-    return {std::hypot(dx, dy) - L, std::atan(sin_e1/cos_e1), std::atan(sin_e2/cos_e2)};
+    return e_pot;
 }
 
-Matrix<3, 6> BeamElement::get_J() const
+double ElementPool<BeamElement>::get_kinetic_energy(const std::vector<size_t>& indices) const
 {
-    double dx = system.get_u(dofs[3]) - system.get_u(dofs[0]);
-    double dy = system.get_u(dofs[4]) - system.get_u(dofs[1]);
+    double e_kin = 0.0;
+    for(size_t i: indices)
+        e_kin += elements[i].get_kinetic_energy();
 
-    double a0 = std::pow(dx*dx + dy*dy, -0.5);
-    double a1 = 1.0/(dx*dx + dy*dy);
+    return e_kin;
+}
 
-    double j0 = a0*dx;
-    double j1 = a0*dy;
-    double j2 = a1*dx;
-    double j3 = a1*dy;
+// Gathers the node displacements of all elements and evaluates the quantities that are shared by the internal forces
+// and the tangent stiffness: The inverse powers of the element lengths and the elastic coordinates.
+// Only the angle of the chord (atan2) is evaluated per element, everything else as array expressions.
+void ElementPool<BeamElement>::update_kinematics() const
+{
+    size_t n = elements.size();
+    dx.resize(n);
+    dy.resize(n);
+    phi0.resize(n);
+    phi1.resize(n);
+    L.resize(n);
 
-    Eigen::Matrix<double, 3, 6> J;
-    J << -j0, -j1, 0.0, j0,  j1, 0.0,
-         -j3,  j2, 1.0, j3, -j2, 0.0,
-         -j3,  j2, 0.0, j3, -j2, 1.0;
+    for(size_t i = 0; i < n; ++i) {
+        const BeamElement& element = elements[i];
+        const System& system = element.system;
+
+        dx[i] = system.get_u(element.dofs[3]) - system.get_u(element.dofs[0]);
+        dy[i] = system.get_u(element.dofs[4]) - system.get_u(element.dofs[1]);
+
+        double phi = std::atan2(dy[i], dx[i]);
+        phi0[i] = system.get_u(element.dofs[2]) + element.phi_ref_0 - phi;
+        phi1[i] = system.get_u(element.dofs[5]) + element.phi_ref_1 - phi;
+        L[i] = element.L;
+    }
+
+    // Inverse powers of the length, see BeamElement::get_a
+    a1 = (dx.square() + dy.square()).inverse();
+    a0 = a1.sqrt();
+    a2 = a0*a1;
+    a3 = a1.square();
 
-    return J;
+    // Elastic coordinates, see BeamElement::get_e
+    e0 = a0.inverse() - L;
+    e1 = phi0 - M_PI*(phi0/M_PI).round();
+    e2 = phi1 - M_PI*(phi1/M_PI).round();
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "solver/fem/Element.hpp"
+#include "solver/fem/ElementContainer.hpp"
 #include "solver/fem/Node.hpp"
 #include "solver/numerics/EigenTypes.hpp"
 #include <array>
@@ -36,5 +37,37 @@ private:
     double L;
 
     Vector<3> get_e() const;
-    Matrix<3, 6> get_J() const;
+
+    // Shared by the element and the element pool. dx, dy: Distance between the nodes, f = K*e: Elastic forces,
+    // a: Inverse powers of the length l, (l^-1, l^-2, l^-3, l^-4), as returned by get_a
+    static Vector<4> get_a(double dx, double dy);
+    static Vector<6> get_q(double dx, double dy, const Vector<4>& a, const Vector<3>& f);
+    static Matrix<6, 6> get_K(double dx, double dy, const Vector<4>& a, const Vector<3>& f, const Matrix<3, 3>& K);
+
+    friend class ElementPool<BeamElement>;
+};
+
+// Element pool for beam elements that evaluates the internal forces and tangent stiffness of all elements in batches.
+// The inverse powers of the lengths and the elastic coordinates are computed for all elements at once on contiguous arrays
+// (structure of arrays), which allows vectorization. The element contributions are then evaluated from them in closed form
+// and added to the system in a single pass over the elements.
+
+template<>
+class ElementPool<BeamElement>: public ElementPoolBase {
+public:
+    std::vector<BeamElement> elements;
+
+    void add_masses() const override;
+    void add_internal_forces() const override;
+    void add_tangent_stiffness() const override;
+    void add_tangent_damping() const override;
+
+    double get_potential_energy(const std::vector<size_t>& indices) const override;
+    double get_kinetic_energy(const std::vector<size_t>& indices) const override;
+
+private:
+    // Per element: Node distances, unwrapped angles, lengths, inverse powers of the length and elastic coordinates
+    mutable ArrayXd dx, dy, phi0, phi1, L, a0, a1, a2, a3, e0, e1, e2;
+
+    void update_kinematics() const;
 };
@@ -71,14 +71,14 @@ void ContactElement::add_masses() const
 
 void ContactElement::add_internal_forces() const
 {
-    State state = get_state();
+    State state = get_state(false);
     system.add_q(dofs, f.force(state.e)*state.De);
 }
 
 void ContactElement::add_tangent_stiffness() const
 {
-    State state = get_state();
-    system.add_K(dofs, f.stiffness(state.e)*state.De*state.De.transpose() + f.force(state.e)*state.e*state.DDe);
+    State state = get_state(true);
+    system.add_K(dofs, f.stiffness(state.e)*state.De*state.De.transpose() + f.force(state.e)*state.DDe);
 }
 
 void ContactElement::add_tangent_damping() const
@@ -88,7 +88,7 @@ void ContactElement::add_tangent_damping() const
 
 double ContactElement::get_potential_energy() const
 {
-    State state = get_state();
+    State state = get_state(false);
     return f.energy(state.e);
 }
 
@@ -97,15 +97,21 @@ double ContactElement::get_kinetic_energy() const
     return 0.0;
 }
 
-ContactElement::State ContactElement::get_state() const
+// Penetration e and its first derivative De. The second derivative DDe is only computed if requested,
+// since the internal forces don't need it. All derivatives of the auxiliary variables a1, ..., a4 are sparse:
+// The gradients have at most four non-zero entries and the hessians are zero except for the entries (2, 2) and (5, 5).
+ContactElement::State ContactElement::get_state(bool hessian) const
 {
+    double s0 = sin(system.get_u(dofs[2]));
+    double c0 = cos(system.get_u(dofs[2]));
+    double s1 = sin(system.get_u(dofs[5]));
+    double c1 = cos(system.get_u(dofs[5]));
+
     Vector<2> P0{system.get_u(dofs[0]), system.get_u(dofs[1])};
     Vector<2> P1{system.get_u(dofs[3]), system.get_u(dofs[4])};
     Vector<2> P2{system.get_u(dofs[6]), system.get_u(dofs[7])};
-    Vector<2> Q0{system.get_u(dofs[0]) + h0*sin(system.get_u(dofs[2])),
-                 system.get_u(dofs[1]) - h0*cos(system.get_u(dofs[2]))};
-    Vector<2> Q1{system.get_u(dofs[3]) + h1*sin(system.get_u(dofs[5])),
-                 system.get_u(dofs[4]) - h1*cos(system.get_u(dofs[5]))};
+    Vector<2> Q0{P0[0] + h0*s0, P0[1] - h0*c0};
+    Vector<2> Q1{P1[0] + h1*s1, P1[1] - h1*c1};
 
     // If no contact, set kinematic expressions to zero and return
     if(get_orientation(P2, P0, Q0) == Orientation::LeftHanded ||
@@ -118,64 +124,53 @@ ContactElement::State ContactElement::get_state() const
 
     // Contact: Calculate kinematic expressions
 
-    // 1. Penetration e
+    // 1. Penetration e = N/r
 
-    double a1 = system.get_u(dofs[3]) - system.get_u(dofs[0]) - h0*sin(system.get_u(dofs[2])) + h1*sin(system.get_u(dofs[5]));
-    double a2 = system.get_u(dofs[4]) - system.get_u(dofs[1]) + h0*cos(system.get_u(dofs[2])) - h1*cos(system.get_u(dofs[5]));
-    double a3 = system.get_u(dofs[6]) - system.get_u(dofs[0]) - h0*sin(system.get_u(dofs[2]));
-    double a4 = system.get_u(dofs[7]) - system.get_u(dofs[1]) + h0*cos(system.get_u(dofs[2]));
+    double a1 = Q1[0] - Q0[0];
+    double a2 = Q1[1] - Q0[1];
+    double a3 = P2[0] - Q0[0];
+    double a4 = P2[1] - Q0[1];
 
-    double e = (a1*a4 - a2*a3)/hypot(a1, a2);
+    double N = a1*a4 - a2*a3;
+    double r = hypot(a1, a2);
+    double e = N/r;
 
-    // 2. First derivative of e
+    // 2. First derivative De = v1/r - N/r^3*v2 with v1 = DN and v2 = r*Dr
 
     Vector<8> Da1, Da2, Da3, Da4;
-    Da1 << -1.0, 0.0, -h0*cos(system.get_u(dofs[2])), 1.0, 0.0, h1*cos(system.get_u(dofs[5])), 0.0, 0.0;
-    Da2 << 0.0, -1.0, -h0*sin(system.get_u(dofs[2])), 0.0, 1.0, h1*sin(system.get_u(dofs[5])), 0.0, 0.0;
-    Da3 << -1.0, 0.0, -h0*cos(system.get_u(dofs[2])), 0.0, 0.0, 0.0, 1.0, 0.0;
-    Da4 << 0.0, -1.0, -h0*sin(system.get_u(dofs[2])), 0.0, 0.0, 0.0, 0.0, 1.0;
+    Da1 << -1.0, 0.0, -h0*c0, 1.0, 0.0, h1*c1, 0.0, 0.0;
+    Da2 << 0.0, -1.0, -h0*s0, 0.0, 1.0, h1*s1, 0.0, 0.0;
+    Da3 << -1.0, 0.0, -h0*c0, 0.0, 0.0, 0.0, 1.0, 0.0;
+    Da4 << 0.0, -1.0, -h0*s0, 0.0, 0.0, 0.0, 0.0, 1.0;
 
-    double b1 = 1.0/hypot(a1, a2);
-    double b2 = (a2*a3 - a1*a4)/pow(a1*a1 + a2*a2, 1.5);
+    Vector<8> v1 = a4*Da1 - a3*Da2 - a2*Da3 + a1*Da4;
+    Vector<8> v2 = a1*Da1 + a2*Da2;
 
-    auto v1 = a4*Da1 - a3*Da2 - a2*Da3 + a1*Da4;
-    auto v2 = a1*Da1 + a2*Da2;
+    double b1 = 1.0/r;
+    double b2 = -N*b1*b1*b1;
 
     Vector<8> De = b1*v1 + b2*v2;
+    if(!hessian) {
+        return {e, De, Matrix<8, 8>()};
+    }
 
-    // 3. Second derivative of e
-    // Todo: Don't actually create sparse matrices DDa1 ... DDa4
-
-    Matrix<8, 8> DDa1 = Matrix<8, 8>::Zero();
-    DDa1(2, 2) = h0*sin(system.get_u(dofs[2]));
-    DDa1(5, 5) = -h1*sin(system.get_u(dofs[5]));
-
-    Matrix<8, 8> DDa2 = Matrix<8, 8>::Zero();
-    DDa2(2, 2) = -h0*cos(system.get_u(dofs[2]));
-    DDa2(5, 5) = h1*cos(system.get_u(dofs[5]));
-
-    Matrix<8, 8> DDa3 = Matrix<8, 8>::Zero();
-    DDa3(2, 2) = h0*sin(system.get_u(dofs[2]));
-
-    Matrix<8, 8> DDa4 = Matrix<8, 8>::Zero();
-    DDa4(2, 2) = -h0*cos(system.get_u(dofs[2]));
-
-    auto Db1 = -(a1*Da1 + a2*Da2)/pow(a1*a1 + a2*a2, 1.5);
+    // 3. Second derivative DDe = b1*Dv1 + b2*Dv2 - (v1*v2^T + v2*v1^T)/r^3 + 3*N/r^5*v2*v2^T
+    // with Dv1 = Da1*Da4^T + Da4*Da1^T - Da2*Da3^T - Da3*Da2^T + (diagonal terms)
+    // and  Dv2 = Da1*Da1^T + Da2*Da2^T + (diagonal terms)
 
-    auto Db2 = hypot(a1, a2)/(pow(a1, 6) + 3.0*pow(a1, 4)*pow(a2, 2) + 3*pow(a1, 2)*pow(a2, 4) + pow(a2, 6))
-             * ((2.0*a1*a1*a4 - a2*a2*a4 - 3.0*a1*a2*a3)*Da1
-              + (a1*a1*a3 - 2.0*a2*a2*a3 + 3.0*a1*a2*a4)*Da2
-              + (a2*a2*a2 + a1*a1*a2)*Da3
-              + (-a1*a1*a1 - a1*a2*a2)*Da4);
+    double b3 = b1*b1*b1;
+    double b4 = 3.0*N*b3*b1*b1;
 
-    auto Dv1 = Da4*Da1.transpose() - Da3*Da2.transpose()
-             - Da2*Da3.transpose() + Da1*Da4.transpose()
-             + a4*DDa1 - a3*DDa2 - a2*DDa3 + a1*DDa4;
+    Matrix<8, 8> DDe;
+    DDe.noalias()  = b1*(Da1*Da4.transpose() - Da2*Da3.transpose());
+    DDe.noalias() -= b3*(v1*v2.transpose());
+    DDe += DDe.transpose().eval();
 
-    auto Dv2 = Da1*Da1.transpose() + Da2*Da2.transpose()
-             + a1*DDa1 + a2*DDa2;
+    DDe.noalias() += b2*(Da1*Da1.transpose() + Da2*Da2.transpose());
+    DDe.noalias() += b4*(v2*v2.transpose());
 
-    Matrix<8, 8> DDe = Db1*v1.transpose() + Db2*v2.transpose() + b1*Dv1 + b2*Dv2;
+    DDe(2, 2) += b1*h0*(s0*(a4 - a2) + c0*(a3 - a1)) + b2*h0*(a1*s0 - a2*c0);
+    DDe(5, 5) -= b1*h1*(a4*s1 + a3*c1) + b2*h1*(a1*s1 - a2*c1);
 
     return {e, De, DDe};
 }
@@ -44,5 +44,5 @@ private:
         Matrix<8, 8> DDe;
     };
 
-    State get_state() const;
+    State get_state(bool hessian) const;
 };
@@ -1,6 +1,5 @@
 #include "ContactHandler.hpp"
 #include "solver/fem/System.hpp"
-#include <boost/range/adaptor/map.hpp>
 
 ContactHandler::ContactHandler(System& system, ContactForce force)
     : Element(system), force(force)
@@ -17,6 +16,7 @@ void ContactHandler::add_segment(const Node& node_a, const Node& node_b, double
     y_coordinates.push_back({segments.size(), Coordinate::SegmentMax, 0.0});
 
     segments.push_back({system, node_a, node_b, ha, hb});
+    updated = false;
 }
 
 void ContactHandler::add_point(const Node& node)
@@ -25,13 +25,78 @@ void ContactHandler::add_point(const Node& node)
     y_coordinates.push_back({points.size(), Coordinate::PointPos, 0.0});
 
     points.push_back({system, node});
+    updated = false;
 }
 
 void ContactHandler::update_contacts() const
 {
+    if(updated && version == system.get_u_version()) {
+        ++counts.skipped;
+        return;
+    }
+
+    // Size of the lookup table changes only when adding segments or points
+    if(positions.size() != segments.size()*points.size()) {
+        positions.assign(segments.size()*points.size(), none);
+        contacts.reserve(positions.size());
+
+        for(size_t k = 0; k < contacts.size(); ++k) {
+            positions[contacts[k].first*points.size() + contacts[k].second] = k;
+        }
+    }
+
     update_coordinates();
     sort_axis(x_coordinates);
     sort_axis(y_coordinates);
+
+    version = system.get_u_version();
+    updated = true;
+    ++counts.updates;
+}
+
+ContactHandler::Counts ContactHandler::get_counts() const
+{
+    Counts result = counts;
+    result.active = contacts.size();
+
+    return result;
+}
+
+ContactHandler::Counts ContactHandler::Counts::operator-(const Counts& other) const
+{
+    return { active, swaps - other.swaps, updates - other.updates, skipped - other.skipped, added - other.added, removed - other.removed };
+}
+
+void ContactHandler::add_contact(size_t i, size_t j) const
+{
+    size_t& position = positions[i*points.size() + j];
+    if(position == none) {
+        position = contacts.size();
+        contacts.push_back({i, j});
+        ++counts.added;
+    }
+}
+
+// Removes a contact by moving the last one into its place
+void ContactHandler::remove_contact(size_t i, size_t j) const
+{
+    size_t& position = positions[i*points.size() + j];
+    if(position != none) {
+        auto last = contacts.back();
+        contacts[position] = last;
+        positions[last.first*points.size() + last.second] = position;
+        contacts.pop_back();
+        position = none;
+        ++counts.removed;
+    }
+}
+
+ContactElement ContactHandler::get_contact(const std::pair<size_t, size_t>& pair) const
+{
+    const Segment& segment = segments[pair.first];
+    const Point& point = points[pair.second];
+
+    return ContactElement(system, segment.node_a, segment.node_b, point.node, segment.h_a, segment.h_b, force);
 }
 
 
@@ -63,15 +128,6 @@ void ContactHandler::update_coordinates() const
 // depending on the occurring swaps. https://en.wikipedia.org/wiki/Insertion_sort
 void ContactHandler::sort_axis(std::vector<Coordinate>& coordinates) const
 {
-    auto add_contact = [&](size_t i, size_t j) {
-        contacts.insert({{i, j}, {system, segments[i].node_a, segments[i].node_b,
-                                  points[j].node, segments[i].h_a, segments[i].h_b, force}});
-    };
-
-    auto remove_contact = [&](size_t i, size_t j) {
-        contacts.erase({i, j});
-    };
-
     for(int j = 1; j < coordinates.size(); j++)
     {
         Coordinate key_element = coordinates[j];    // Element that is being placed in it's correct position
@@ -116,6 +172,7 @@ void ContactHandler::sort_axis(std::vector<Coordinate>& coordinates) const
 
             coordinates[i + 1] = swap_element;
             i -= 1;
+            ++counts.swaps;
         }
 
         coordinates[i + 1] = key_element;
@@ -131,16 +188,16 @@ void ContactHandler::add_internal_forces() const
 {
     update_contacts();
 
-    for(auto& e: contacts | boost::adaptors::map_values)
-        e.add_internal_forces();
+    for(auto& pair: contacts)
+        get_contact(pair).add_internal_forces();
 }
 
 void ContactHandler::add_tangent_stiffness() const
 {
-    update_contacts();    // Todo: Avoid Recomputation.
+    update_contacts();
 
-    for(auto& e: contacts | boost::adaptors::map_values)
-        e.add_tangent_stiffness();
+    for(auto& pair: contacts)
+        get_contact(pair).add_tangent_stiffness();
 }
 
 void ContactHandler::add_tangent_damping() const
@@ -150,9 +207,11 @@ void ContactHandler::add_tangent_damping() const
 
 double ContactHandler::get_potential_energy() const
 {
+    update_contacts();
+
     double T = 0.0;
-    for(auto& e: contacts | boost::adaptors::map_values)
-        T += e.get_potential_energy();
+    for(auto& pair: contacts)
+        T += get_contact(pair).get_potential_energy();
 
     return T;
 }
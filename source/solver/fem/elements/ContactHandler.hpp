@@ -2,8 +2,8 @@
 #include "solver/fem/elements/ContactElement.hpp"
 #include "solver/fem/Element.hpp"
 #include "solver/fem/Node.hpp"
+#include "solver/fem/Dependency.hpp"
 #include <vector>
-#include <map>
 
 // Holds a collection of segments (two nodes, two distances) and points (one node) and creates/removes
 // contact elements for them as needed. It uses the Sweep and Prune broadphase algorithm [1],[2] along
@@ -12,8 +12,9 @@
 // [1] https://github.com/mattleisolver/model/jitterphysics/wiki/Sweep-and-Prune
 // [2] http://codercorner.com/SAP.pdf
 //
-// Todo: Dynamic memory allocation when inserting in the map. Maybe try unordered_map?
-// It has a reserve method, but iteration should be slower.
+// The active contacts are stored as a flat list of (segment, point) pairs with a lookup table of their positions,
+// both allocated once for the maximum possible number of contacts. The contact elements themselves are created
+// on the fly when evaluating a pair. The broadphase is skipped if the displacements haven't changed since the last update.
 
 class ContactHandler: public Element
 {
@@ -53,6 +54,18 @@ private:
     };
 
 public:
+    // Cumulative statistics of the broadphase, per-step values by taking differences
+    struct Counts {
+        size_t active = 0;          // Number of currently active contacts
+        unsigned long swaps = 0;    // Swaps of coordinates while sorting
+        unsigned long updates = 0;  // Broadphase updates
+        unsigned long skipped = 0;  // Broadphase updates skipped due to unchanged displacements
+        unsigned long added = 0;    // Contacts created
+        unsigned long removed = 0;  // Contacts removed
+
+        Counts operator-(const Counts& other) const;
+    };
+
     ContactHandler(System& system, ContactForce force);
     void add_segment(const Node& node_a, const Node& node_b, double ha, double hb);
     void add_point(const Node& node);
@@ -60,6 +73,7 @@ public:
     void update_contacts() const;
     void update_coordinates() const;
     void sort_axis(std::vector<Coordinate>& coordinates) const;
+    Counts get_counts() const;
 
     virtual void add_masses() const override;
     virtual void add_internal_forces() const override;
@@ -76,6 +90,17 @@ private:
 
     mutable std::vector<Coordinate> x_coordinates;
     mutable std::vector<Coordinate> y_coordinates;
-    mutable std::map<std::pair<size_t, size_t>, ContactElement> contacts;
+    mutable std::vector<std::pair<size_t, size_t>> contacts;    // Active contacts (segment index, point index)
+    mutable std::vector<size_t> positions;                       // Position in contacts for each (segment, point) pair, or none
+
+    mutable IndependentBase::Version version = 0;    // Displacement version of the last update
+    mutable bool updated = false;
+    mutable Counts counts;
+
+    static constexpr size_t none = -1;
+
+    void add_contact(size_t i, size_t j) const;
+    void remove_contact(size_t i, size_t j) const;
+    ContactElement get_contact(const std::pair<size_t, size_t>& pair) const;
 };
 
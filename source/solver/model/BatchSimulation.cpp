@@ -0,0 +1,190 @@
+#include "BatchSimulation.hpp"
+#include "solver/numerics/Linspace.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <set>
+
+ParameterRange::ParameterRange(const std::string& text) {
+    size_t separator = text.find('=');
+    if(separator == std::string::npos) {
+        throw std::runtime_error("Invalid parameter range " + text + ": Expected pointer=values");
+    }
+
+    pointer = text.substr(0, separator);
+
+    // Split value part at ':' or ','
+    std::string list = text.substr(separator + 1);
+    char delimiter = (list.find(':') != std::string::npos) ? ':' : ',';
+
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    for(std::string item; std::getline(stream, item, delimiter); ) {
+        items.push_back(item);
+    }
+
+    try {
+        if(delimiter == ':') {
+            if(items.size() != 3) {
+                throw std::runtime_error("Expected start:end:n");
+            }
+
+            double start = std::stod(items[0]);
+            double end = std::stod(items[1]);
+            int n = std::stoi(items[2]);
+
+            if(n < 1) {
+                throw std::runtime_error("Number of values must be positive");
+            }
+
+            values = (n == 1) ? std::vector<double>{start} : linspace(start, end, n);
+        }
+        else {
+            for(auto& item: items) {
+                values.push_back(std::stod(item));
+            }
+        }
+    }
+    catch(const std::exception& e) {
+        throw std::runtime_error("Invalid parameter range " + text + ": " + e.what());
+    }
+
+    if(values.empty()) {
+        throw std::runtime_error("Invalid parameter range " + text + ": No values");
+    }
+}
+
+std::vector<BatchVariant> create_variants(const std::string& name, const InputData& input, const std::vector<ParameterRange>& ranges) {
+    if(ranges.empty()) {
+        return {{name, input, {}}};
+    }
+
+    size_t n_variants = 1;
+    for(auto& range: ranges) {
+        n_variants *= range.values.size();
+    }
+
+    size_t digits = std::to_string(n_variants - 1).size();
+
+    std::vector<BatchVariant> variants;
+    for(size_t i = 0; i < n_variants; ++i) {
+        std::stringstream suffix;
+        suffix << std::setw(digits) << std::setfill('0') << i;
+
+        BatchVariant variant{name + "_" + suffix.str(), input, {}};
+
+        // Decompose the variant index into one index per range, the last range varying fastest
+        size_t index = i;
+        for(size_t j = ranges.size(); j-- > 0; ) {
+            double value = ranges[j].values[index % ranges[j].values.size()];
+            index /= ranges[j].values.size();
+
+            variant.input.set_value(ranges[j].pointer, value);
+            variant.parameters.insert(variant.parameters.begin(), value);
+        }
+
+        variants.push_back(variant);
+    }
+
+    return variants;
+}
+
+BatchSimulation::BatchSimulation(SimulationMode mode, const std::string& directory, unsigned threads, OutputData::Format format)
+    : mode(mode),
+      directory(directory),
+      threads(std::max(threads, 1u)),
+      format(format)
+{
+
+}
+
+// The variants are distributed dynamically: Each thread takes the next unprocessed variant until none are left.
+// This balances the load if the simulation times of the variants differ.
+std::vector<BatchSummary> BatchSimulation::run(const std::vector<BatchVariant>& variants, const Callback& callback) const {
+    // Variants with the same name would write to the same result and temporary files concurrently
+    std::set<std::string> names;
+    for(auto& variant: variants) {
+        if(!names.insert(variant.name).second) {
+            throw std::runtime_error("Duplicate variant name " + variant.name + ": Input files must have different base names");
+        }
+    }
+
+    std::vector<BatchSummary> summaries(variants.size());
+    std::atomic<size_t> next = 0;
+    std::mutex mutex;
+
+    auto work = [&]() {
+        for(size_t i = next++; i < variants.size(); i = next++) {
+            summaries[i] = simulate(variants[i]);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            callback(summaries[i]);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for(unsigned i = 0; i < std::min<size_t>(threads, variants.size()); ++i) {
+        workers.emplace_back(work);
+    }
+
+    for(auto& worker: workers) {
+        worker.join();
+    }
+
+    return summaries;
+}
+
+BatchSummary BatchSimulation::simulate(const BatchVariant& variant) const {
+    BatchSummary summary;
+    summary.name = variant.name;
+    summary.parameters = variant.parameters;
+
+    try {
+        // The dynamic states are streamed to temporary files next to the result, which bounds the memory per thread
+        std::string path = (std::filesystem::path(directory) / (variant.name + ".res")).string();
+        FileSink sink(path);
+
+        OutputData output = BowModel::simulate(variant.input, mode, [](int, int){}, sink);
+        output.save(path, format);
+
+        summary.final_draw_force = output.statics.final_draw_force;
+        summary.drawing_work = output.statics.drawing_work;
+        summary.energy_storage_factor = output.statics.energy_storage_factor;
+        summary.final_vel_arrow = output.dynamics.final_vel_arrow;
+        summary.efficiency = output.dynamics.efficiency;
+    }
+    catch(const std::exception& e) {
+        summary.error = e.what();
+    }
+
+    return summary;
+}
+
+void BatchSimulation::save_summary(const std::string& path, const std::vector<ParameterRange>& ranges, const std::vector<BatchSummary>& summaries) {
+    std::ofstream stream(path);
+    stream.exceptions(~std::ofstream::goodbit);    // Make stream throw exception on failure
+    stream << std::setprecision(10);
+
+    stream << "name";
+    for(auto& range: ranges) {
+        stream << "\t" << range.pointer;
+    }
+    stream << "\tfinal_draw_force\tdrawing_work\tenergy_storage_factor\tfinal_vel_arrow\tefficiency\terror\n";
+
+    for(auto& summary: summaries) {
+        stream << summary.name;
+        for(double value: summary.parameters) {
+            stream << "\t" << value;
+        }
+        stream << "\t" << summary.final_draw_force
+               << "\t" << summary.drawing_work
+               << "\t" << summary.energy_storage_factor
+               << "\t" << summary.final_vel_arrow
+               << "\t" << summary.efficiency
+               << "\t" << summary.error << "\n";
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "solver/model/BowModel.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+// Range of values for a numeric model parameter, identified by a JSON pointer into the model file (see InputData::set_value).
+// Parsed from the formats "pointer=v1,v2,..." (list of values) or "pointer=start:end:n" (n linearly spaced values).
+struct ParameterRange {
+    std::string pointer;
+    std::vector<double> values;
+
+    ParameterRange(const std::string& text);
+};
+
+// Single model to be simulated as part of a batch
+struct BatchVariant {
+    std::string name;                 // Name of the variant, used for the result file
+    InputData input;
+    std::vector<double> parameters;   // Values of the varied parameters, in the order of the ranges
+};
+
+// Key results of a single variant for the summary table
+struct BatchSummary {
+    std::string name;
+    std::vector<double> parameters;
+    std::string error;    // Empty if the simulation succeeded
+
+    double final_draw_force = 0.0;
+    double drawing_work = 0.0;
+    double energy_storage_factor = 0.0;
+    double final_vel_arrow = 0.0;
+    double efficiency = 0.0;
+};
+
+// Creates the variants of a model for all combinations of the parameter ranges.
+// The variants are named by the base name and a running index. Without any ranges the base model is the only variant.
+std::vector<BatchVariant> create_variants(const std::string& name, const InputData& input, const std::vector<ParameterRange>& ranges);
+
+// Simulates the variants in parallel on the given number of threads and saves each result as <directory>/<name>.res.
+// Failing simulations don't stop the batch, their error message is reported in the summary instead.
+// The variant names must be unique, otherwise run() throws before simulating anything.
+// The callback is called after each finished variant, possibly from different threads but never concurrently.
+class BatchSimulation {
+public:
+    using Callback = std::function<void(const BatchSummary&)>;
+
+    BatchSimulation(SimulationMode mode, const std::string& directory, unsigned threads, OutputData::Format format = OutputData::Format::Binary);
+    std::vector<BatchSummary> run(const std::vector<BatchVariant>& variants, const Callback& callback) const;
+
+    // Saves the summaries as a table of tab separated values with one line per variant
+    static void save_summary(const std::string& path, const std::vector<ParameterRange>& ranges, const std::vector<BatchSummary>& summaries);
+
+private:
+    SimulationMode mode;
+    std::string directory;
+    unsigned threads;
+    OutputData::Format format;
+
+    BatchSummary simulate(const BatchVariant& variant) const;
+};
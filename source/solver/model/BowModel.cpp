@@ -3,6 +3,7 @@
 #include "solver/fem/EigenvalueSolver.hpp"
 #include "solver/fem/StaticSolver.hpp"
 #include "solver/fem/DynamicSolver.hpp"
+#include "solver/fem/Profiler.hpp"
 #include "solver/fem/elements/BeamElement.hpp"
 #include "solver/fem/elements/BarElement.hpp"
 #include "solver/fem/elements/MassElement.hpp"
@@ -10,26 +11,84 @@
 #include "solver/fem/elements/ContactHandler.hpp"
 #include "solver/numerics/RootFinding.hpp"
 #include "solver/numerics/Geometry.hpp"
+#include "solver/numerics/Utils.hpp"
+#include <optional>
 #include <limits>
 #include <numeric>
 #include <cmath>
 
+// Adds the updates of the system's dependent quantities and the changes of the contacts during its lifetime as counters to the enclosing profiler scope
+class ProfileCounts
+{
+public:
+    ProfileCounts(const System& system)
+        : system(system),
+          updates(system.get_update_counts()),
+          contacts(get_contact_counts())
+    {
+
+    }
+
+    ~ProfileCounts() {
+        System::UpdateCounts u = system.get_update_counts() - updates;
+        PROFILE_COUNT("updates/a", u.a);
+        PROFILE_COUNT("updates/q", u.q);
+        PROFILE_COUNT("updates/M", u.M);
+        PROFILE_COUNT("updates/K", u.K);
+        PROFILE_COUNT("updates/D", u.D);
+
+        ContactHandler::Counts c = get_contact_counts() - contacts;
+        PROFILE_COUNT("contact/added", c.added);
+        PROFILE_COUNT("contact/removed", c.removed);
+        PROFILE_COUNT("contact/updates", c.updates);
+        PROFILE_COUNT("contact/skipped", c.skipped);
+    }
+
+private:
+    const System& system;
+    System::UpdateCounts updates;
+    ContactHandler::Counts contacts;
+
+    // The contact handler only exists after the string was created
+    ContactHandler::Counts get_contact_counts() const {
+        auto group = system.get_elements().group<ContactHandler>("contact");
+        return group.empty() ? ContactHandler::Counts() : group.front().get_counts();
+    }
+};
+
 OutputData BowModel::simulate(const InputData& input, SimulationMode mode, const Callback& callback) {
-    BowModel model(input);
+    MemorySink sink;
+    return simulate(input, mode, callback, sink);
+}
+
+OutputData BowModel::simulate(const InputData& input, SimulationMode mode, const Callback& callback, StateSink& dynamic_sink, const CancelFn& canceled,
+                              const StaticStepping& stepping) {
+    BowModel model(input, canceled, stepping);
 
     SetupData setup = model.simulate_setup(callback);
     BowStates static_states = model.simulate_statics(callback);
+
+    StateSummary static_summary(setup.limb_properties.layers);
+    StateSummary dynamic_summary(setup.limb_properties.layers);
     BowStates dynamic_states;
 
     if(mode == SimulationMode::Dynamic) {
-        dynamic_states = model.simulate_dynamics(callback);
+        model.simulate_dynamics(callback, dynamic_sink, dynamic_summary);
+    }
+
+    PROFILE_SCOPE("output");
+    static_summary.add(static_states);
+    if(mode == SimulationMode::Dynamic) {
+        dynamic_states = dynamic_sink.finish();
     }
 
-    return OutputData(setup, static_states, dynamic_states);
+    return OutputData(setup, std::move(static_states), static_summary, std::move(dynamic_states), dynamic_summary);
 }
 
-BowModel::BowModel(const InputData& input)
-    : input(input)
+BowModel::BowModel(const InputData& input, const CancelFn& canceled, const StaticStepping& stepping)
+    : input(input),
+      canceled(canceled),
+      stepping(stepping)
 {
     std::string error = input.validate();
     if(!error.empty()) {
@@ -37,7 +96,14 @@ BowModel::BowModel(const InputData& input)
     }
 }
 
+void BowModel::check_canceled() const {
+    if(canceled && canceled()) {
+        throw SimulationCanceled();
+    }
+}
+
 void BowModel::init_limb(const Callback& callback, SetupData& output) {
+    PROFILE_SCOPE("limb");
     LimbProperties limb_properties(input);
 
     // Create limb nodes
@@ -70,16 +136,36 @@ void BowModel::init_limb(const Callback& callback, SetupData& output) {
     // Tune damping parameter
 
     EigenvalueSolver solver(system);
-    auto try_damping_parameter = [&](double beta) {
+    auto set_damping_parameter = [&](double beta) {
         for(auto& element: system.mut_elements().group<BeamElement>("limb")) {
             element.set_damping(beta);
         }
+    };
 
+    auto try_damping_parameter = [&](double beta) {
+        check_canceled();
+        set_damping_parameter(beta);
         return solver.compute_minimum_frequency().zeta - input.damping.damping_ratio_limbs;
     };
 
-    if(input.damping.damping_ratio_limbs > 0.0)
-        secant_method(try_damping_parameter, 1.0, 1.5, 1e-5, 15);    // Magic numbers
+    if(input.damping.damping_ratio_limbs > 0.0) {
+        PROFILE_SCOPE("damping");
+
+        // The damping matrix is linear in beta, D = beta*D1. To first order, the damping ratio of the undamped mode (omega, phi) is
+        // zeta = beta*phi^T*D1*phi/(2*omega*phi^T*M*phi), which is exact if D is proportional to M.
+        // The limb elements only approximately fulfill this, as they damp their rotational dofs like the translational ones.
+        // Therefore the estimate is checked with the damped system and only corrected iteratively if necessary.
+        ModeShape mode = solver.compute_minimum_undamped_mode();
+        set_damping_parameter(1.0);
+
+        double beta = 2.0*mode.omega*input.damping.damping_ratio_limbs/mode.phi.dot(system.get_D()*mode.phi);    // phi^T*M*phi = 1
+        double error = try_damping_parameter(beta);
+
+        if(std::abs(error) > 1e-5) {    // Magic number
+            double zeta = error + input.damping.damping_ratio_limbs;
+            secant_method(try_damping_parameter, beta, beta*input.damping.damping_ratio_limbs/zeta, 1e-5, 15);    // Magic numbers
+        }
+    }
 
     // Assign discrete limb properties
     output.limb_properties = limb_properties;
@@ -87,9 +173,10 @@ void BowModel::init_limb(const Callback& callback, SetupData& output) {
 }
 
 void BowModel::init_string(const Callback& callback, SetupData& output) {
+    PROFILE_SCOPE("string");
     LimbProperties& limb_properties = output.limb_properties;
 
-    const double k = 0.1*std::abs(system.get_K().maxCoeff());         // Contact stiffness in terms of maximum stiffness already present // Magic number
+    const double k = 0.1*std::abs(system.get_K().coeffs().maxCoeff());         // Contact stiffness in terms of maximum stiffness already present // Magic number
     const double epsilon = 0.01*limb_properties.height.minCoeff();    // Initial penetration of the contact elements // Magic number
 
     // Calculate curve tangential to the limb and calculate string node positions by equipartition
@@ -140,6 +227,9 @@ void BowModel::init_string(const Callback& callback, SetupData& output) {
     StaticSolverDC solver(system, nodes_string[0].y);   // Todo: Reuse solver across function calls?
     StaticSolverDC::Info info;
     auto try_element_length = [&](double l) {
+        PROFILE_SCOPE("brace_search");
+        check_canceled();
+
         for(auto& element: system.mut_elements().group<BarElement>("string")) {
             element.set_length(l);
         }
@@ -208,6 +298,9 @@ void BowModel::init_masses(const Callback& callback, SetupData& output) {
 }
 
 SetupData BowModel::simulate_setup(const Callback& callback) {
+    PROFILE_SCOPE("setup");
+    ProfileCounts counts(system);
+
     SetupData output;
     init_limb(callback, output);
     init_string(callback, output);
@@ -216,26 +309,138 @@ SetupData BowModel::simulate_setup(const Callback& callback) {
     return output;
 }
 
+// Computes the static equilibrium states from brace height to full draw.
+// The initial guess for each solver step is extrapolated from the last two equilibrium states (secant predictor).
+// The step size is adapted to the difference between predicted and actual equilibrium, which estimates the error
+// of linear interpolation between the states. The output states at the requested draw lengths are interpolated.
 BowStates BowModel::simulate_statics(const Callback& callback) {
+    PROFILE_SCOPE("statics");
+    ProfileCounts counts(system);
+
+    const unsigned n_out = input.settings.n_draw_steps;
+
     BowStates output;
+    output.reserve(n_out);
+    auto output_draw_length = [&](unsigned i) {
+        double eta = double(i)/(n_out - 1);
+        return (1.0 - eta)*input.dimensions.brace_height + eta*input.dimensions.draw_length;
+    };
+
+    // Step size control, steps start at the spacing of the output states
+    const double draw_span = input.dimensions.draw_length - input.dimensions.brace_height;
+    const double h_out = draw_span/std::max(n_out - 1, 1u);
+    const double h_max = std::max(h_out, draw_span/stepping.min_steps);
+    const double h_min = stepping.min_step*h_out;
+    double h = h_out;
+
+    // Equilibrium state of the system at a draw length
+    struct State {
+        double draw_length;
+        VectorXd u;
+        VectorXd p;
+    };
+
+    auto get_state = [&](double draw_length) {
+        return State{draw_length, system.get_u(), system.get_p()};
+    };
+
+    auto set_state = [&](const State& state) {
+        system.set_u(state.u);
+        system.set_p(state.p);
+    };
 
+    // Sets the system to a linear inter- or extrapolation between the states a and b at the given draw length.
+    // The displacement of the string center is set exactly, since it would otherwise be affected by rounding errors.
+    auto set_interpolated = [&](const State& a, const State& b, double draw_length) {
+        double t = (draw_length - a.draw_length)/(b.draw_length - a.draw_length);
+        VectorXd u = (1.0 - t)*a.u + t*b.u;
+        u(nodes_string[0].y.index) = -draw_length;
+        system.set_u(u);
+        system.set_p((1.0 - t)*a.p + t*b.p);
+    };
+
+    // Ratio of the corrector step to the total step for one quantity, zero if undefined
+    auto error_ratio = [](const VectorXd& x_prev, const VectorXd& x_pred, const VectorXd& x) {
+        double step = (x - x_prev).norm();
+        return (step != 0.0) ? (x - x_pred).norm()/step : 0.0;
+    };
+
+    // First output state: Equilibrium at brace height
     system.set_p(nodes_string[0].y, 1.0);    // Will be scaled by the static algorithm
-    StaticSolverDC solver(system, nodes_string[0].y);
-    for(unsigned i = 0; i < input.settings.n_draw_steps; ++i) {
-        double eta = double(i)/(input.settings.n_draw_steps - 1);
-        double draw_length = (1.0 - eta)*input.dimensions.brace_height + eta*input.dimensions.draw_length;
+    StaticSolverDC solver(system, nodes_string[0].y, stepping.strategy);
+    solver.solve(-output_draw_length(0));
+    add_state(output);
+    callback(0, 0);
+
+    State current = get_state(output_draw_length(0));
+    std::optional<State> previous;
+
+    unsigned i = 1;    // Index of the next output state
+    while(i < n_out) {
+        check_canceled();
+        double draw_length = std::min(current.draw_length + h, input.dimensions.draw_length);
+
+        // Predictor
+        std::optional<State> predicted;
+        if(previous) {
+            set_interpolated(*previous, current, draw_length);
+            predicted = get_state(draw_length);
+        }
+
+        // Corrector
+        StaticSolverDC::Info info = solver.solve(-draw_length);
+        if(info.outcome != StaticSolverDC::Info::Success) {
+            // Reset to the last equilibrium and retry with a smaller step
+            PROFILE_COUNT("failed_steps", 1);
+            set_state(current);
+            h *= 0.5;
+            if(h < h_min) {
+                throw std::runtime_error("Failed to find the static equilibrium of the drawn bow");
+            }
+            continue;
+        }
 
-        solver.solve(-draw_length);
-        add_state(output);
+        previous = current;
+        current = get_state(draw_length);
 
-        callback(std::round(100.0*eta), 0);
+        // Interpolate output states between the previous and the current equilibrium
+        while(i < n_out && (output_draw_length(i) <= current.draw_length || current.draw_length == input.dimensions.draw_length)) {
+            set_interpolated(*previous, current, output_draw_length(i));
+            add_state(output);
+            callback(std::round(100.0*i/(n_out - 1)), 0);
+            ++i;
+        }
+
+        set_state(current);
+
+        // Adjust step size. The predictor error is of second order in the step size, so its ratio to the step is of first order.
+        if(stepping.adaptive && predicted) {
+            double r = std::max(error_ratio(previous->u, predicted->u, current.u), error_ratio(previous->p, predicted->p, current.p));
+            h = clamp(h*std::min(stepping.r_tol/r, 2.0), h_min, h_max);
+        }
     }
 
     return output;
 }
 
-BowStates BowModel::simulate_dynamics(const Callback& callback) {
-    BowStates output;
+// The states are collected in chunks of limited size, which are summarized and passed on to the sink
+void BowModel::simulate_dynamics(const Callback& callback, StateSink& sink, StateSummary& summary) {
+    PROFILE_SCOPE("dynamics");
+    ProfileCounts counts(system);
+
+    const size_t chunk_size = sink.chunk_size();
+    size_t n_states = 0;    // Number of states passed to the sink
+
+    BowStates chunk;
+    chunk.reserve(chunk_size);
+
+    auto flush_chunk = [&] {
+        PROFILE_SCOPE("flush");
+        summary.add(chunk);
+        sink.write(chunk);
+        n_states += chunk.time.size();
+        chunk.clear();
+    };
 
     // Set draw force to zero
     system.set_p(nodes_string[0].y, 0.0);
@@ -261,9 +466,11 @@ BowStates BowModel::simulate_dynamics(const Callback& callback) {
                 T = (uT - ut)/v + t;
             }
             else {
-                // Arrow has reached brace height: Set T to current time and stop estimations
+                // Arrow has reached brace height: Set T to current time and stop estimations.
+                // The number of remaining output states is known now.
                 T = system.get_t();
                 estimated = false;
+                sink.reserve(n_states + chunk.time.size() + size_t(std::ceil((alpha - 1.0)*T*input.settings.sampling_rate)) + 1);
             }
         }
 
@@ -272,16 +479,20 @@ BowStates BowModel::simulate_dynamics(const Callback& callback) {
 
     auto run_solver = [&](DynamicSolver& solver) {        
         do {
-            add_state(output);
+            add_state(chunk);
+            if(chunk.time.size() == chunk_size) {
+                flush_chunk();
+            }
             callback(100, std::round(100.0*system.get_t()/(alpha*T)));
         } while(solver.step());
     };
 
-    // Determine solver timestep
-    double dt = DynamicSolver::estimate_timestep(system, input.settings.time_step_factor);
+    // The solvers adapt their timestep to the current stiffness of the system
+    DynamicSolver::AdaptiveTimestep timestep{ input.settings.time_step_factor };
 
     // Create and run solver for the first phase (arrow attached to the string)
-    DynamicSolver solver1(system, dt, input.settings.sampling_rate, [&]{
+    DynamicSolver solver1(system, timestep, input.settings.sampling_rate, [&]{
+        check_canceled();
         return condition_arrow_departure() || condition_simulation_stop();    // Stopping criterion for the inner loop of the simulation
     });
     run_solver(solver1);
@@ -292,16 +503,20 @@ BowStates BowModel::simulate_dynamics(const Callback& callback) {
         node_arrow = system.create_node(nodes_string[0]);
         system.mut_elements().front<MassElement>("arrow").set_node(node_arrow);
 
-        DynamicSolver solver2(system, dt, input.settings.sampling_rate, [&]{
+        DynamicSolver solver2(system, timestep, input.settings.sampling_rate, [&]{
+            check_canceled();
             return condition_simulation_stop();    // Stopping criterion for the inner loop of the simulation
         });
         run_solver(solver2);
     }
 
-    return output;
+    flush_chunk();
 }
 
 void BowModel::add_state(BowStates& states) const {
+    PROFILE_COUNT("states", 1);
+    PROFILE_SCOPE("add_state");
+
     states.time.push_back(system.get_t());
     states.draw_force.push_back(-2.0*system.get_p(nodes_string[0].y));    // *2 because of symmetry
     states.draw_length.push_back(-system.get_u(nodes_string[0].y));
@@ -338,28 +553,28 @@ void BowModel::add_state(BowStates& states) const {
     states.e_kin_arrow.push_back(e_kin_arrow);
 
     // Limb and string coordinates
-    states.x_pos_limb.push_back(VectorXd(nodes_limb.size()));
-    states.y_pos_limb.push_back(VectorXd(nodes_limb.size()));
-    states.angle_limb.push_back(VectorXd(nodes_limb.size()));
+    StateArray::Row x_pos_limb = states.x_pos_limb.append(nodes_limb.size());
+    StateArray::Row y_pos_limb = states.y_pos_limb.append(nodes_limb.size());
+    StateArray::Row angle_limb = states.angle_limb.append(nodes_limb.size());
 
     for(size_t i = 0; i < nodes_limb.size(); ++i) {
-        states.x_pos_limb.back()[i] = system.get_u(nodes_limb[i].x);
-        states.y_pos_limb.back()[i] = system.get_u(nodes_limb[i].y);
-        states.angle_limb.back()[i] = system.get_u(nodes_limb[i].phi);
+        x_pos_limb[i] = system.get_u(nodes_limb[i].x);
+        y_pos_limb[i] = system.get_u(nodes_limb[i].y);
+        angle_limb[i] = system.get_u(nodes_limb[i].phi);
     }
 
-    states.x_pos_string.push_back(VectorXd(nodes_string.size()));
-    states.y_pos_string.push_back(VectorXd(nodes_string.size()));
+    StateArray::Row x_pos_string = states.x_pos_string.append(nodes_string.size());
+    StateArray::Row y_pos_string = states.y_pos_string.append(nodes_string.size());
 
     for(size_t i = 0; i < nodes_string.size(); ++i) {
-        states.x_pos_string.back()[i] = system.get_u(nodes_string[i].x);
-        states.y_pos_string.back()[i] = system.get_u(nodes_string[i].y);
+        x_pos_string[i] = system.get_u(nodes_string[i].x);
+        y_pos_string[i] = system.get_u(nodes_string[i].y);
     }
 
     // Limb deformation
 
-    VectorXd epsilon(nodes_limb.size());
-    VectorXd kappa(nodes_limb.size());
+    StateArray::Row epsilon = states.epsilon.append(nodes_limb.size());
+    StateArray::Row kappa = states.kappa.append(nodes_limb.size());
 
     auto elements = system.get_elements().group<BeamElement>("limb");
     for(size_t i = 0; i < nodes_limb.size(); ++i) {
@@ -376,7 +591,4 @@ void BowModel::add_state(BowStates& states) const {
             kappa[i] = 0.5*(elements[i-1].get_kappa(1.0) + elements[i].get_kappa(0.0));
         }
     }
-
-    states.epsilon.push_back(epsilon);
-    states.kappa.push_back(kappa);
 }
@@ -1,33 +1,62 @@
 #pragma once
 #include "solver/model/input/InputData.hpp"
 #include "solver/model/output/OutputData.hpp"
+#include "solver/model/output/StateSink.hpp"
 #include "solver/fem/System.hpp"
+#include "solver/fem/StaticSolver.hpp"
 #include <functional>
+#include <stdexcept>
 
 enum class SimulationMode {
     Static,
     Dynamic
 };
 
+// Thrown by the simulation when it is canceled
+class SimulationCanceled: public std::runtime_error {
+public:
+    SimulationCanceled(): std::runtime_error("Simulation canceled") {}
+};
+
+// Step size control of the static simulation. The defaults are meant for all regular simulations.
+struct StaticStepping {
+    bool adaptive = true;       // Adapt the step size to the predictor error, otherwise only halve it after failed steps
+    double r_tol = 0.05;        // Desired ratio of predictor error and step
+    unsigned min_steps = 50;    // Limits the step to the draw span divided by this number, unless the output states are further apart
+    double min_step = 1e-5;     // Minimum step relative to the spacing of the output states, the simulation fails below
+    StaticSolver::Strategy strategy;    // Solver settings for the steps
+};
+
 class BowModel {
 public:
     using Callback = std::function<void(int, int)>;    // Progress (static, dynamic) in percent
+    using CancelFn = std::function<bool()>;            // Returns true if the simulation should be canceled
+
     static OutputData simulate(const InputData& input, SimulationMode mode, const Callback& callback);
 
+    // Writes the dynamic states to the sink while simulating instead of keeping them in memory.
+    // The optional cancel function is checked regularly inside the solver loops, e.g. for stopping a simulation that runs on a worker thread.
+    // If it returns true, the simulation is aborted with a SimulationCanceled exception.
+    static OutputData simulate(const InputData& input, SimulationMode mode, const Callback& callback, StateSink& dynamic_sink, const CancelFn& canceled = nullptr,
+                               const StaticStepping& stepping = {});
+
 private:
-    BowModel(const InputData& input);
+    BowModel(const InputData& input, const CancelFn& canceled, const StaticStepping& stepping);
+    void check_canceled() const;
     void init_limb(const Callback& callback, SetupData& output);
     void init_string(const Callback& callback, SetupData& output);
     void init_masses(const Callback& callback, SetupData& output);
 
     SetupData simulate_setup(const Callback& callback);
     BowStates simulate_statics(const Callback& callback);
-    BowStates simulate_dynamics(const Callback& callback);
+    void simulate_dynamics(const Callback& callback, StateSink& sink, StateSummary& summary);
 
     void add_state(BowStates& states) const;
 
 private:
     const InputData& input;
+    CancelFn canceled;
+    StaticStepping stepping;
 
     System system;
     std::vector<Node> nodes_limb;
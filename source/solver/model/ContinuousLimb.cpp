@@ -24,6 +24,17 @@ double ContinuousLayer::get_h(double s) const
     return height(limb.get_p(s), 0.0);  // Zero if out of bounds
 }
 
+// Zero if out of bounds
+void ContinuousLayer::get_h(const std::vector<double>& p, std::vector<double>& h) const
+{
+    height.evaluate(p, &h);
+    for(size_t i = 0; i < p.size(); ++i) {
+        if(p[i] < height.arg_min() || p[i] > height.arg_max()) {
+            h[i] = 0.0;
+        }
+    }
+}
+
 double ContinuousLayer::get_rho() const
 {
     return rho;
@@ -140,3 +151,62 @@ double ContinuousLimb::get_rhoA(double s) const
     return rhoA;
 }
 
+// Deliberately matches get_C in evaluating the width spline at the arc length s for the stiffness parameters,
+// while width and rhoA use the relative position like get_w and get_rhoA.
+void ContinuousLimb::evaluate(const std::vector<double>& s, SectionGrid& grid) const
+{
+    size_t n = s.size();
+
+    // Profile
+    grid.x_pos.resize(n);
+    grid.y_pos.resize(n);
+    grid.angle.resize(n);
+    for(size_t i = 0; i < n; ++i) {
+        Vector<3> r = get_r(s[i]);
+        grid.x_pos[i] = r[0];
+        grid.y_pos[i] = r[1];
+        grid.angle[i] = r[2];
+    }
+
+    // Width
+    grid.p.resize(n);
+    for(size_t i = 0; i < n; ++i) {
+        grid.p[i] = get_p(s[i]);
+    }
+    width.evaluate(grid.p, &grid.width);
+    width.evaluate(s, &grid.width_C);
+
+    // Layer transitions: Evaluate the layer heights into y[j+1], then subtract them from the previous transition
+    grid.y.resize(layers.size() + 1);
+    grid.y[0].assign(n, 0.0);
+    for(size_t j = 0; j < layers.size(); ++j) {
+        layers[j].get_h(grid.p, grid.y[j+1]);
+        for(size_t i = 0; i < n; ++i) {
+            grid.y[j+1][i] = grid.y[j][i] - grid.y[j+1][i];
+        }
+    }
+
+    // Section properties, summed over the layers
+    grid.height.assign(n, 0.0);
+    grid.rhoA.assign(n, 0.0);
+    grid.Cee.assign(n, 0.0);
+    grid.Ckk.assign(n, 0.0);
+    grid.Cek.assign(n, 0.0);
+    for(size_t j = 0; j < layers.size(); ++j) {
+        double rho = layers[j].get_rho();
+        double E = layers[j].get_E();
+
+        for(size_t i = 0; i < n; ++i) {
+            double h = grid.y[j][i] - grid.y[j+1][i];
+            double A = grid.width_C[i]*h;
+            double y = 0.5*(grid.y[j][i] + grid.y[j+1][i]);
+            double I = A*(h*h/12.0 + y*y);
+
+            grid.height[i] += h;
+            grid.rhoA[i] += rho*grid.width[i]*h;
+            grid.Cee[i] += E*A;
+            grid.Ckk[i] += E*I;
+            grid.Cek[i] -= E*A*y;
+        }
+    }
+}
@@ -5,6 +5,30 @@
 
 class ContinuousLimb;
 
+// Cross section properties of the limb on a grid of arc lengths, with one vector per quantity
+struct SectionGrid
+{
+    // Position and orientation of the centerline
+    std::vector<double> x_pos;
+    std::vector<double> y_pos;
+    std::vector<double> angle;
+
+    // Section geometry
+    std::vector<double> width;
+    std::vector<double> height;
+    std::vector<std::vector<double>> y;    // Coordinates of the layer transitions from back to belly, y[j][i] is transition j at grid point i
+
+    // Section properties
+    std::vector<double> rhoA;
+    std::vector<double> Cee;
+    std::vector<double> Ckk;
+    std::vector<double> Cek;
+
+    // Intermediate results, kept for reuse by the next evaluation
+    std::vector<double> p;          // Relative positions
+    std::vector<double> width_C;    // Width for the stiffness parameters, see ContinuousLimb::evaluate
+};
+
 class ContinuousLayer
 {
 public:
@@ -14,6 +38,7 @@ public:
     double s_max() const;
 
     double get_h(double s) const;
+    void get_h(const std::vector<double>& p, std::vector<double>& h) const;    // Heights at multiple relative positions p, see ContinuousLimb::get_p
     double get_rho() const;
     double get_E() const;
 
@@ -45,6 +70,10 @@ public:
     Matrix<2> get_C(double s) const;               // Calculates the section's stiffness parameters Cee, Ckk, Cek
     double get_rhoA(double s) const;                  // Calculates the section's linear density
 
+    // Evaluates all of the above at the given arc lengths at once, which is much faster than evaluating them one by one.
+    // The vectors of the grid are resized if necessary, so a grid can be reused for multiple evaluations without allocations.
+    void evaluate(const std::vector<double>& s, SectionGrid& grid) const;
+
 private:
     ProfileCurve profile;
     CubicSpline width;
@@ -3,6 +3,55 @@
 #include "solver/model/ContinuousLimb.hpp"
 #include "solver/numerics/Linspace.hpp"
 
+using nlohmann::json;
+
+VectorXd LayerProperties::get_stress_back(const Ref<const VectorXd>& epsilon, const Ref<const VectorXd>& kappa) const
+{
+    return He_back.cwiseProduct(epsilon) + Hk_back.cwiseProduct(kappa);
+}
+
+VectorXd LayerProperties::get_stress_belly(const Ref<const VectorXd>& epsilon, const Ref<const VectorXd>& kappa) const
+{
+    return He_belly.cwiseProduct(epsilon) + Hk_belly.cwiseProduct(kappa);
+}
+
+void to_json(json& obj, const LayerProperties& layer)
+{
+    obj["name"] = layer.name;
+    obj["color"] = layer.color;
+    obj["rho"] = layer.rho;
+    obj["E"] = layer.E;
+    obj["length"] = layer.length;
+    obj["He_back"] = layer.He_back;
+    obj["Hk_back"] = layer.Hk_back;
+    obj["He_belly"] = layer.He_belly;
+    obj["Hk_belly"] = layer.Hk_belly;
+}
+
+void from_json(const json& obj, LayerProperties& layer)
+{
+    // Older result files contain the stress coefficients as diagonal matrices
+    auto get_coefficients = [&](const char* name, VectorXd& coefficients) {
+        const json& value = obj.at(name);
+        if(!value.empty() && value.at(0).is_array()) {
+            coefficients = value.get<MatrixXd>().diagonal();
+        }
+        else {
+            value.get_to(coefficients);
+        }
+    };
+
+    obj.at("name").get_to(layer.name);
+    obj.at("color").get_to(layer.color);
+    obj.at("rho").get_to(layer.rho);
+    obj.at("E").get_to(layer.E);
+    obj.at("length").get_to(layer.length);
+    get_coefficients("He_back", layer.He_back);
+    get_coefficients("Hk_back", layer.Hk_back);
+    get_coefficients("He_belly", layer.He_belly);
+    get_coefficients("Hk_belly", layer.Hk_belly);
+}
+
 LimbProperties::LimbProperties(const InputData& input)
     : LimbProperties(input, input.settings.n_limb_elements + 1)
 {
@@ -21,43 +70,45 @@ LimbProperties::LimbProperties(const InputData& input, unsigned n)
       Ckk(VectorXd::Zero(n)),
       Cek(VectorXd::Zero(n)),
       m(n-1),
-      layers(input.layers.size(), LayerProperties(n, n))
+      layers(input.layers.size(), LayerProperties(n))
 {
     ContinuousLimb limb(input);
 
     std::vector<double> s = linspace(0.0, limb.length(), n);
+    SectionGrid grid;
+    limb.evaluate(s, grid);
+
     for(size_t i = 0; i < n; ++i) {
         // Profile
-        Vector<3> r = limb.get_r(s[i]);
         length[i] = s[i];
-        x_pos[i] = r[0];
-        y_pos[i] = r[1];
-        angle[i] = r[2];
+        x_pos[i] = grid.x_pos[i];
+        y_pos[i] = grid.y_pos[i];
+        angle[i] = grid.angle[i];
 
         // Geometry
-        width[i] = limb.get_w(s[i]);
-        height[i] = limb.get_h(s[i]);
+        width[i] = grid.width[i];
+        height[i] = grid.height[i];
 
         // Section properties
-        rhoA[i] = limb.get_rhoA(s[i]);
-        Matrix<2, 2> C = limb.get_C(s[i]);
-        Cee[i] = C(0, 0);
-        Ckk[i] = C(1, 1);
-        Cek[i] = C(0, 1);
-
-        // Layer properties
-        auto y = limb.get_y(s[i]);
-        for(size_t j = 0; j < input.layers.size(); ++j) {
-            layers[j].length(i) = s[i];
+        rhoA[i] = grid.rhoA[i];
+        Cee[i] = grid.Cee[i];
+        Ckk[i] = grid.Ckk[i];
+        Cek[i] = grid.Cek[i];
+    }
 
-            // Todo: Add method to ContinuousLimb to calculate those
-            auto& material = input.materials.at(input.layers[j].material);
+    // Layer properties
+    for(size_t j = 0; j < input.layers.size(); ++j) {
+        // Todo: Add method to ContinuousLimb to calculate those
+        auto& material = input.materials.at(input.layers[j].material);
+
+        for(size_t i = 0; i < n; ++i) {
+            layers[j].length(i) = s[i];
 
-            layers[j].He_back(i, i) =  material.E;
-            layers[j].He_belly(i, i) = material.E;
+            layers[j].He_back(i) =  material.E;
+            layers[j].He_belly(i) = material.E;
 
-            layers[j].Hk_back(i, i) = -material.E*y[j];
-            layers[j].Hk_belly(i, i) = -material.E*y[j+1];
+            layers[j].Hk_back(i) = -material.E*grid.y[j][i];
+            layers[j].Hk_belly(i) = -material.E*grid.y[j+1][i];
         }
     }
 
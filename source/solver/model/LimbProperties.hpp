@@ -15,26 +15,34 @@ struct LayerProperties
 
     VectorXd length;
 
-    MatrixXd He_back;
-    MatrixXd Hk_back;
+    // Stress coefficients per node: sigma = He*epsilon + Hk*kappa
+    VectorXd He_back;
+    VectorXd Hk_back;
 
-    MatrixXd He_belly;
-    MatrixXd Hk_belly;
+    VectorXd He_belly;
+    VectorXd Hk_belly;
 
     LayerProperties() = default;
 
-    // n: Limb nodex, k: Layer nodes
-    LayerProperties(unsigned n, unsigned k)
-        : length(VectorXd::Zero(k)),
-          He_back(MatrixXd::Zero(k, n)),
-          He_belly(MatrixXd::Zero(k, n)),
-          Hk_back(MatrixXd::Zero(k, n)),
-          Hk_belly(MatrixXd::Zero(k, n))
+    // n: Limb nodes
+    LayerProperties(unsigned n)
+        : length(VectorXd::Zero(n)),
+          He_back(VectorXd::Zero(n)),
+          Hk_back(VectorXd::Zero(n)),
+          He_belly(VectorXd::Zero(n)),
+          Hk_belly(VectorXd::Zero(n))
     {
 
     }
+
+    // Stresses at the nodes for the given strains and curvatures of the limb
+    VectorXd get_stress_back(const Ref<const VectorXd>& epsilon, const Ref<const VectorXd>& kappa) const;
+    VectorXd get_stress_belly(const Ref<const VectorXd>& epsilon, const Ref<const VectorXd>& kappa) const;
 };
 
+void to_json(nlohmann::json& obj, const LayerProperties& layer);
+void from_json(const nlohmann::json& obj, LayerProperties& layer);
+
 struct LimbProperties
 {
     // Nodes
@@ -65,5 +73,4 @@ struct LimbProperties
     LimbProperties(const InputData& input, unsigned n);
 };
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(LayerProperties, name, color, rho, E, length, He_back, Hk_back, He_belly, Hk_belly)
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(LimbProperties, length, angle, x_pos, y_pos, width, height, rhoA, Cee, Ckk, Cek, layers)
@@ -3,6 +3,7 @@
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <iomanip>
+#include <cmath>
 
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Settings, n_limb_elements, n_string_elements, n_draw_steps, arrow_clamp_force, time_span_factor, time_step_factor, sampling_rate)
 
@@ -38,6 +39,30 @@ void InputData::save(const std::string& path) const {
     stream << std::setw(4) << obj << std::endl;
 }
 
+// Sets a numeric value of the model that is identified by a JSON pointer into the model file, e.g. /string/n_strands or /layers/0/height/1/1
+void InputData::set_value(const std::string& pointer, double value) {
+    json obj;
+    to_json(obj, *this);
+
+    try {
+        json& target = obj.at(json::json_pointer(pointer));
+        if(target.is_number_integer()) {
+            target = std::lround(value);
+        }
+        else if(target.is_number()) {
+            target = value;
+        }
+        else {
+            throw std::runtime_error("Model value " + pointer + " is not a number");
+        }
+    }
+    catch(const json::exception& e) {
+        throw std::runtime_error("Invalid model value " + pointer + ": " + e.what());
+    }
+
+    from_json(obj, *this);
+}
+
 std::string InputData::validate() const {
     // Check Settings
     if(settings.n_limb_elements < 1) {
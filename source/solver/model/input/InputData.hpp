@@ -73,5 +73,6 @@ struct InputData {
     InputData(const std::string& path);
 
     void save(const std::string& path) const;
+    void set_value(const std::string& pointer, double value);
     std::string validate() const;
 };
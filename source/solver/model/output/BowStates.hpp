@@ -1,7 +1,8 @@
 #pragma once
-#include "solver/numerics/EigenTypes.hpp"
+#include "solver/model/output/StateArray.hpp"
 #include <nlohmann/json.hpp>
 #include <vector>
+#include <type_traits>
 
 struct BowStates
 {
@@ -23,38 +24,89 @@ struct BowStates
     std::vector<double> e_kin_string;
     std::vector<double> e_kin_arrow;
 
-    std::vector<VectorXd> x_pos_limb;
-    std::vector<VectorXd> y_pos_limb;
-    std::vector<VectorXd> angle_limb;
+    StateArray x_pos_limb;
+    StateArray y_pos_limb;
+    StateArray angle_limb;
 
-    std::vector<VectorXd> x_pos_string;
-    std::vector<VectorXd> y_pos_string;
+    StateArray x_pos_string;
+    StateArray y_pos_string;
 
-    std::vector<VectorXd> epsilon;
-    std::vector<VectorXd> kappa;
+    StateArray epsilon;
+    StateArray kappa;
+
+    // Calls f(name, field) for all fields, e.g. for serialization
+    template<class F>
+    void visit(F&& f) {
+        visit_fields(f, *this);
+    }
+
+    template<class F>
+    void visit(F&& f) const {
+        visit_fields(f, *this);
+    }
+
+    // Reserves memory for the given number of states in all fields
+    void reserve(size_t n) {
+        visit([&](const char*, auto& field) {
+            field.reserve(n);
+        });
+    }
+
+    // Removes all states, keeps the allocated memory
+    void clear() {
+        visit([&](const char*, auto& field) {
+            field.clear();
+        });
+    }
+
+    // Adds the states of other to the end
+    void append(const BowStates& other) {
+        visit_fields([&](const char*, auto& field, const auto& other_field) {
+            if constexpr(std::is_same_v<std::decay_t<decltype(field)>, StateArray>) {
+                field.append(other_field);
+            }
+            else {
+                field.insert(field.end(), other_field.begin(), other_field.end());
+            }
+        }, *this, other);
+    }
+
+private:
+    // Calls f(name, field, ...) with the corresponding fields of multiple states
+    template<class F, class... States>
+    static void visit_fields(F&& f, States&... states) {
+        f("time", states.time...);
+        f("draw_length", states.draw_length...);
+        f("draw_force", states.draw_force...);
+        f("string_force", states.string_force...);
+        f("strand_force", states.strand_force...);
+        f("grip_force", states.grip_force...);
+        f("pos_arrow", states.pos_arrow...);
+        f("vel_arrow", states.vel_arrow...);
+        f("acc_arrow", states.acc_arrow...);
+        f("e_pot_limbs", states.e_pot_limbs...);
+        f("e_kin_limbs", states.e_kin_limbs...);
+        f("e_pot_string", states.e_pot_string...);
+        f("e_kin_string", states.e_kin_string...);
+        f("e_kin_arrow", states.e_kin_arrow...);
+        f("x_pos_limb", states.x_pos_limb...);
+        f("y_pos_limb", states.y_pos_limb...);
+        f("angle_limb", states.angle_limb...);
+        f("x_pos_string", states.x_pos_string...);
+        f("y_pos_string", states.y_pos_string...);
+        f("epsilon", states.epsilon...);
+        f("kappa", states.kappa...);
+    }
 };
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
-        BowStates,
-        time,
-        draw_length,
-        draw_force,
-        string_force,
-        strand_force,
-        grip_force,
-        pos_arrow,
-        vel_arrow,
-        acc_arrow,
-        e_pot_limbs,
-        e_kin_limbs,
-        e_pot_string,
-        e_kin_string,
-        e_kin_arrow,
-        x_pos_limb,
-        y_pos_limb,
-        angle_limb,
-        x_pos_string,
-        y_pos_string,
-        epsilon,
-        kappa
-)
+inline void to_json(nlohmann::json& obj, const BowStates& states) {
+    states.visit([&](const char* name, const auto& field) {
+        obj[name] = field;
+    });
+}
+
+inline void from_json(const nlohmann::json& obj, BowStates& states) {
+    states.visit([&](const char* name, auto& field) {
+        obj.at(name).get_to(field);
+    });
+}
@@ -28,9 +28,9 @@ struct DynamicData
     std::vector<std::pair<unsigned, unsigned>> max_stress_index;
 };
 
+// The states are serialized separately, see OutputData
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
         DynamicData,
-        states,
         final_pos_arrow,
         final_vel_arrow,
         final_e_pot_limbs,
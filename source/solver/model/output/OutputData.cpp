@@ -1,129 +1,272 @@
 #include "OutputData.hpp"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <nlohmann/json.hpp>
 #include <fstream>
+#include <filesystem>
+#include <cstring>
+#include <type_traits>
 
 using nlohmann::json;
 
-void OutputData::save(const std::string& path) const
+// Layout of the binary result files (native byte order, i.e. little endian on all supported platforms):
+// 8 bytes magic number, 8 bytes index offset, 8 bytes index size, state arrays (doubles), index (MessagePack)
+static const char magic[8] = {'V', 'B', 'R', 'E', 'S', 'U', 'L', 'T'};
+static const size_t header_size = sizeof(magic) + 2*sizeof(uint64_t);
+
+// Replaces the target file with the source file. Loaded results may still map the target (see load_binary).
+// On POSIX the rename keeps the old file alive as long as it is mapped. Windows can't replace or delete a mapped file,
+// but it can rename it, so the old file is moved aside and removed if it isn't mapped anymore.
+static void replace_file(const std::filesystem::path& source, const std::filesystem::path& target)
 {
-    // https://github.com/nlohmann/json/issues/479
-    std::vector<uint8_t> buffer = json::to_msgpack(*this);
-    std::ofstream stream(path, std::ios::out | std::ios::binary);
-    stream.exceptions(~std::ofstream::goodbit);    // Make stream throw exception on failure
-    stream.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+#ifdef _WIN32
+    if(std::filesystem::exists(target)) {
+        std::filesystem::path aside = target;
+        aside += ".old";
+        for(int i = 1; std::filesystem::exists(aside); ++i) {
+            std::error_code error;
+            if(std::filesystem::remove(aside, error)) {
+                break;
+            }
+
+            aside = target;
+            aside += ".old" + std::to_string(i);
+        }
+
+        std::error_code error;
+        std::filesystem::rename(target, aside);
+        std::filesystem::remove(aside, error);
+    }
+#endif
+    std::filesystem::rename(source, target);
+}
+
+void OutputData::save(const std::string& path, Format format) const
+{
+    std::string temp = path + ".tmp";
+
+    try {
+        std::ofstream stream(temp, std::ios::out | std::ios::binary | std::ios::trunc);
+        stream.exceptions(~std::ofstream::goodbit);    // Make stream throw exception on failure
+
+        if(format == Format::Binary) {
+            save_binary(stream);
+        }
+        else {
+            // https://github.com/nlohmann/json/issues/479
+            std::vector<uint8_t> buffer = json::to_msgpack(*this);
+            stream.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+        }
+
+        stream.close();
+        replace_file(temp, path);
+    }
+    catch(...) {
+        std::error_code error;
+        std::filesystem::remove(temp, error);
+        throw;
+    }
 }
 
 OutputData::OutputData(const std::string& path)
 {
-    // https://github.com/nlohmann/json/issues/479
     std::ifstream stream(path, std::ios::binary);
-    stream.exceptions(~std::ofstream::goodbit);    // Make stream throw exception on failure
-    std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
-    json obj = json::from_msgpack(buffer);
+
+    // Binary files start with the magic number, everything else is assumed to be MessagePack
+    char buffer[sizeof(magic)] = {};
+    stream.exceptions(std::ifstream::badbit);      // Files shorter than the magic number are no error here
+    stream.read(buffer, sizeof(magic));
+    if(stream.gcount() == sizeof(magic) && std::memcmp(buffer, magic, sizeof(magic)) == 0) {
+        load_binary(path);
+        return;
+    }
+
+    stream.clear();
+    stream.seekg(0);
+    stream.exceptions(~std::ofstream::goodbit);
+
+    // https://github.com/nlohmann/json/issues/479
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    json obj = json::from_msgpack(bytes);
     from_json(obj, *this);
 }
 
-// Todo: Remove computations from here
-OutputData::OutputData(SetupData setup, BowStates static_states, BowStates dynamic_states)
-    : setup(setup)
+void OutputData::save_binary(std::ofstream& stream) const
 {
-    // Helper functions
+    uint64_t offset = header_size;
+    stream.write(magic, sizeof(magic));
+    stream.write(std::string(2*sizeof(uint64_t), '\0').data(), 2*sizeof(uint64_t));    // Placeholder for the index position
 
-    auto abs_max_order = [](double a, double b) {
-        return std::abs(a) < std::abs(b);
+    // Writes the state arrays and returns their positions in the file
+    auto write_states = [&](const BowStates& states) {
+        json arrays;
+        auto write_array = [&](const char* name, const double* data, size_t rows, size_t cols) {
+            stream.write(reinterpret_cast<const char*>(data), rows*cols*sizeof(double));
+            arrays[name] = {{"offset", offset}, {"rows", rows}, {"cols", cols}};
+            offset += rows*cols*sizeof(double);
+        };
+
+        states.visit([&](const char* name, const auto& field) {
+            if constexpr(std::is_same_v<std::decay_t<decltype(field)>, StateArray>) {
+                write_array(name, field.data(), field.size(), field.cols());
+            }
+            else {
+                write_array(name, field.data(), field.size(), 1);
+            }
+        });
+
+        return arrays;
     };
 
-    auto max_abs_force = [&](const std::vector<double>& vec) {
-        return std::max_element(vec.begin(), vec.end(), abs_max_order) - vec.begin();
+    json index = {
+        {"version", version},
+        {"setup", setup},
+        {"statics", statics},
+        {"dynamics", dynamics}
     };
 
-    auto min_max_stress = [&](const BowStates& states,
-                            std::vector<double>& min_stress_value, std::vector<std::pair<unsigned, unsigned>>& min_stress_index,
-                            std::vector<double>& max_stress_value, std::vector<std::pair<unsigned, unsigned>>& max_stress_index)
-    {
-        for(const LayerProperties& layer: setup.limb_properties.layers) {
-            double sigma_min = std::numeric_limits<double>::max();
-            std::pair<unsigned, unsigned> index_min = {0, 0};
-
-            double sigma_max = std::numeric_limits<double>::lowest();
-            std::pair<unsigned, unsigned> index_max = {0, 0};
-
-            for(size_t i = 0; i < states.time.size(); ++i) {
-                VectorXd sigma_back = layer.He_back * states.epsilon[i] + layer.Hk_back * states.kappa[i];
-                VectorXd sigma_belly = layer.He_belly * states.epsilon[i] + layer.Hk_belly * states.kappa[i];
-
-                for(int j = 0; j < layer.length.size(); ++j) {
-                    if(sigma_back[j] > sigma_max) {
-                        sigma_max = sigma_back[j];
-                        index_max = {i, j};
-                    }
-                    if(sigma_back[j] < sigma_min) {
-                        sigma_min = sigma_back[j];
-                        index_min = {i, j};
-                    }
-                    if(sigma_belly[j] > sigma_max) {
-                        sigma_max = sigma_belly[j];
-                        index_max = {i, j};
-                    }
-                    if(sigma_belly[j] < sigma_min) {
-                        sigma_min = sigma_belly[j];
-                        index_min = {i, j};
-                    }
-                }
-            }
+    index["statics"]["states"] = write_states(statics.states);
+    index["dynamics"]["states"] = write_states(dynamics.states);
+
+    std::vector<uint8_t> buffer = json::to_msgpack(index);
+    stream.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+
+    uint64_t position[2] = {offset, buffer.size()};
+    stream.seekp(sizeof(magic));
+    stream.write(reinterpret_cast<const char*>(position), sizeof(position));
+}
+
+void OutputData::load_binary(const std::string& path)
+{
+    using namespace boost::interprocess;
 
-            min_stress_value.push_back(sigma_min);
-            min_stress_index.push_back(index_min);
+    // The mapping stays alive as long as any of the state arrays refers to it
+    file_mapping file(path.c_str(), read_only);
+    auto region = std::make_shared<mapped_region>(file, read_only);
 
-            max_stress_value.push_back(sigma_max);
-            max_stress_index.push_back(index_max);
+    const char* begin = static_cast<const char*>(region->get_address());
+    size_t size = region->get_size();
+
+    auto check_range = [&](uint64_t offset, uint64_t length) {
+        if(offset > size || length > size - offset) {
+            throw std::runtime_error("Invalid result file");
         }
     };
 
+    uint64_t position[2];
+    check_range(0, header_size);
+    std::memcpy(position, begin + sizeof(magic), sizeof(position));
+    check_range(position[0], position[1]);
+
+    json index = json::from_msgpack(begin + position[0], begin + position[0] + position[1]);
+    index.at("version").get_to(version);
+    index.at("setup").get_to(setup);
+    index.at("statics").get_to(statics);
+    index.at("dynamics").get_to(dynamics);
+
+    auto read_states = [&](const json& arrays, BowStates& states) {
+        states.visit([&](const char* name, auto& field) {
+            uint64_t offset = arrays.at(name).at("offset");
+            uint64_t rows = arrays.at(name).at("rows");
+            uint64_t cols = arrays.at(name).at("cols");
+
+            // Checked before multiplying, so that the size can't overflow
+            if(rows != 0 && cols > size/sizeof(double)/rows) {
+                throw std::runtime_error("Invalid result file");
+            }
+
+            check_range(offset, rows*cols*sizeof(double));
+            if(offset % alignof(double) != 0) {
+                throw std::runtime_error("Invalid result file");
+            }
+
+            // Scalar values are copied, node values are referenced
+            const double* data = reinterpret_cast<const double*>(begin + offset);
+            if constexpr(std::is_same_v<std::decay_t<decltype(field)>, StateArray>) {
+                field = StateArray(region, data, rows, cols);
+            }
+            else {
+                field.assign(data, data + rows);
+            }
+        });
+    };
+
+    read_states(index.at("statics").at("states"), statics.states);
+    read_states(index.at("dynamics").at("states"), dynamics.states);
+}
+
+void to_json(json& obj, const OutputData& data)
+{
+    obj = {
+        {"version", data.version},
+        {"setup", data.setup},
+        {"statics", data.statics},
+        {"dynamics", data.dynamics}
+    };
+
+    obj["statics"]["states"] = data.statics.states;
+    obj["dynamics"]["states"] = data.dynamics.states;
+}
+
+void from_json(const json& obj, OutputData& data)
+{
+    obj.at("version").get_to(data.version);
+    obj.at("setup").get_to(data.setup);
+    obj.at("statics").get_to(data.statics);
+    obj.at("dynamics").get_to(data.dynamics);
+    obj.at("statics").at("states").get_to(data.statics.states);
+    obj.at("dynamics").at("states").get_to(data.dynamics.states);
+}
+
+OutputData::OutputData(SetupData setup, BowStates static_states, const StateSummary& static_summary,
+                       BowStates dynamic_states, const StateSummary& dynamic_summary)
+    : setup(setup)
+{
     // Assign bow states
-    statics.states = static_states;
-    dynamics.states = dynamic_states;
-
-    // Calculate static numbers
-    if(!statics.states.time.empty()) {
-        double draw_length_front = static_states.draw_length.front();
-        double draw_length_back = static_states.draw_length.back();
-        double draw_force_back = static_states.draw_force.back();
-        double e_pot_front = static_states.e_pot_limbs.front() + static_states.e_pot_string.front();
-        double e_pot_back = static_states.e_pot_limbs.back() + static_states.e_pot_string.back();
-
-        statics.final_draw_force = draw_force_back;
-        statics.drawing_work = e_pot_back - e_pot_front;
-        statics.energy_storage_factor = (e_pot_back - e_pot_front)/(0.5*(draw_length_back - draw_length_front)*draw_force_back);
-        statics.max_string_force_index = max_abs_force(static_states.string_force);
-        statics.max_grip_force_index = max_abs_force(static_states.grip_force);
-        statics.max_draw_force_index = max_abs_force(static_states.draw_force);
-
-        min_max_stress(static_states, statics.min_stress_value, statics.min_stress_index, statics.max_stress_value, statics.max_stress_index);
+    statics.states = std::move(static_states);
+    dynamics.states = std::move(dynamic_states);
+
+    // Static numbers
+    if(static_summary.size() != 0) {
+        statics.final_draw_force = static_summary.last_draw_force;
+        statics.drawing_work = static_summary.last_e_pot - static_summary.first_e_pot;
+        statics.energy_storage_factor = statics.drawing_work/(0.5*(static_summary.last_draw_length - static_summary.first_draw_length)*static_summary.last_draw_force);
+        statics.max_string_force_index = static_summary.max_string_force_index;
+        statics.max_grip_force_index = static_summary.max_grip_force_index;
+        statics.max_draw_force_index = static_summary.max_draw_force_index;
+
+        for(size_t i = 0; i < setup.limb_properties.layers.size(); ++i) {
+            const StressEnvelope::Extrema& extrema = static_summary.stresses.get(i);
+            statics.min_stress_value.push_back(extrema.min_value);
+            statics.min_stress_index.push_back(extrema.min_index);
+            statics.max_stress_value.push_back(extrema.max_value);
+            statics.max_stress_index.push_back(extrema.max_index);
+        }
     }
 
-    // Calculate dynamic numbers
-    if(!dynamics.states.time.empty()) {
-        for(size_t i = 0; i < dynamic_states.time.size(); ++i) {
-            // Find point of arrow separation
-            if(dynamic_states.acc_arrow[i] == 0.0) {
-                dynamics.final_pos_arrow = dynamic_states.pos_arrow[i];
-                dynamics.final_vel_arrow = dynamic_states.vel_arrow[i];
-                dynamics.final_e_pot_limbs = dynamic_states.e_pot_limbs[i];
-                dynamics.final_e_kin_limbs = dynamic_states.e_kin_limbs[i];
-                dynamics.final_e_pot_string = dynamic_states.e_pot_string[i];
-                dynamics.final_e_kin_string = dynamic_states.e_kin_string[i];
-                dynamics.final_e_kin_arrow = dynamic_states.e_kin_arrow[i];
-                dynamics.arrow_departure_index = i;
-                break;
-            }
+    // Dynamic numbers
+    if(dynamic_summary.size() != 0) {
+        if(dynamic_summary.arrow_departure_index) {
+            dynamics.final_pos_arrow = dynamic_summary.final_pos_arrow;
+            dynamics.final_vel_arrow = dynamic_summary.final_vel_arrow;
+            dynamics.final_e_pot_limbs = dynamic_summary.final_e_pot_limbs;
+            dynamics.final_e_kin_limbs = dynamic_summary.final_e_kin_limbs;
+            dynamics.final_e_pot_string = dynamic_summary.final_e_pot_string;
+            dynamics.final_e_kin_string = dynamic_summary.final_e_kin_string;
+            dynamics.final_e_kin_arrow = dynamic_summary.final_e_kin_arrow;
+            dynamics.arrow_departure_index = *dynamic_summary.arrow_departure_index;
         }
 
         dynamics.efficiency = dynamics.final_e_kin_arrow/statics.drawing_work;
-        dynamics.max_string_force_index = max_abs_force(dynamic_states.string_force);
-        dynamics.max_grip_force_index = max_abs_force(dynamic_states.grip_force);
+        dynamics.max_string_force_index = dynamic_summary.max_string_force_index;
+        dynamics.max_grip_force_index = dynamic_summary.max_grip_force_index;
 
-        min_max_stress(dynamic_states, dynamics.min_stress_value, dynamics.min_stress_index, dynamics.max_stress_value, dynamics.max_stress_index);
+        for(size_t i = 0; i < setup.limb_properties.layers.size(); ++i) {
+            const StressEnvelope::Extrema& extrema = dynamic_summary.stresses.get(i);
+            dynamics.min_stress_value.push_back(extrema.min_value);
+            dynamics.min_stress_index.push_back(extrema.min_index);
+            dynamics.max_stress_value.push_back(extrema.max_value);
+            dynamics.max_stress_index.push_back(extrema.max_index);
+        }
     }
 }
-
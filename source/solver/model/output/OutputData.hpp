@@ -2,13 +2,23 @@
 #include "solver/model/output/SetupData.hpp"
 #include "solver/model/output/StaticData.hpp"
 #include "solver/model/output/DynamicData.hpp"
+#include "solver/model/output/StateSummary.hpp"
 #include "config.hpp"
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <iomanip>
 
+// Result files are written in a binary format that consists of a header, the arrays of the bow states
+// and an index at the end. The index is the MessagePack serialization of the output data without the states,
+// plus the offset and size of each state array. On loading, the file is memory mapped and the arrays of node values
+// refer directly to the mapped memory, so only the parts that are actually accessed are read from disk.
+// The older format, all data serialized with MessagePack, can still be read and written.
+// Files are saved to a temporary file that then replaces the target, since the target may still be mapped by a loaded result.
+
 struct OutputData
 {
+    enum class Format { Binary, MsgPack };
+
     std::string version = Config::APPLICATION_VERSION;
     SetupData setup;
     StaticData statics;
@@ -16,9 +26,15 @@ struct OutputData
 
     OutputData() = default;    // Todo: Make this one obsolete
     OutputData(const std::string& path);
-    OutputData(SetupData setup, BowStates static_states, BowStates dynamic_states);
+    OutputData(SetupData setup, BowStates static_states, const StateSummary& static_summary,
+               BowStates dynamic_states, const StateSummary& dynamic_summary);
+
+    void save(const std::string& path, Format format = Format::Binary) const;
 
-    void save(const std::string& path) const;
+private:
+    void save_binary(std::ofstream& stream) const;
+    void load_binary(const std::string& path);
 };
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(OutputData, version, setup, statics, dynamics)
+void to_json(nlohmann::json& obj, const OutputData& data);
+void from_json(const nlohmann::json& obj, OutputData& data);
@@ -0,0 +1,53 @@
+#pragma once
+#include <atomic>
+#include <vector>
+
+// Fixed size queue for passing values from one producer thread to one consumer thread without locking.
+// The producer only modifies the tail index and the consumer only the head index, the slot between them is always left empty.
+template<typename T>
+class RingBuffer
+{
+public:
+    RingBuffer(size_t capacity)
+        : slots(capacity + 1),
+          head(0),
+          tail(0)
+    {
+
+    }
+
+    // Producer: Moves the value into the queue, returns false if the queue is full
+    bool try_push(T& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t next = (t + 1) % slots.size();
+        if(next == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        slots[t] = std::move(value);
+        tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: Moves the oldest value out of the queue, returns false if the queue is empty
+    bool try_pop(T& value) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if(h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        value = std::move(slots[h]);
+        head.store((h + 1) % slots.size(), std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: Whether the queue is empty
+    bool empty() const {
+        return head.load(std::memory_order_relaxed) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<T> slots;
+    std::atomic<size_t> head;    // Index of the next value to pop
+    std::atomic<size_t> tail;    // Index of the next free slot
+};
@@ -0,0 +1,136 @@
+#include "StateArray.hpp"
+#include <cmath>
+
+StateArray::StateArray(std::shared_ptr<const void> owner, const double* data, size_t rows, size_t cols)
+    : n_cols(cols),
+      owner(owner),
+      external(data),
+      n_external(rows*cols)
+{
+
+}
+
+size_t StateArray::size() const
+{
+    return (n_cols != 0) ? (external ? n_external : values.size())/n_cols : 0;
+}
+
+size_t StateArray::cols() const
+{
+    return n_cols;
+}
+
+bool StateArray::empty() const
+{
+    return size() == 0;
+}
+
+// Takes effect with the first state if the number of values is still unknown
+void StateArray::reserve(size_t rows)
+{
+    detach();
+    reserved = rows;
+    values.reserve(rows*n_cols);
+}
+
+StateArray::Row StateArray::append(size_t n)
+{
+    detach();
+    set_cols(n);
+    values.resize(values.size() + n);
+    return Row(values.data() + values.size() - n, n);
+}
+
+void StateArray::push_back(const Ref<const VectorXd>& values)
+{
+    append(values.size()) = values;
+}
+
+void StateArray::append(const StateArray& other)
+{
+    if(!other.empty()) {
+        detach();
+        set_cols(other.cols());
+        values.insert(values.end(), other.data(), other.data() + other.size()*other.cols());
+    }
+}
+
+void StateArray::clear()
+{
+    values.clear();
+    external = nullptr;
+    n_external = 0;
+    owner.reset();
+}
+
+StateArray::ConstRow StateArray::operator[](size_t i) const
+{
+    return ConstRow(data() + i*n_cols, n_cols);
+}
+
+StateArray::Row StateArray::mut(size_t i)
+{
+    detach();
+    return Row(values.data() + i*n_cols, n_cols);
+}
+
+StateArray::ConstRow StateArray::front() const
+{
+    return (*this)[0];
+}
+
+StateArray::ConstRow StateArray::back() const
+{
+    return (*this)[size() - 1];
+}
+
+const double* StateArray::data() const
+{
+    return external ? external : values.data();
+}
+
+// Sets the number of values per state if there are no states yet, otherwise checks it
+void StateArray::set_cols(size_t n)
+{
+    if(values.empty()) {
+        n_cols = n;
+        values.reserve(reserved*n_cols);
+    }
+    else if(n != n_cols) {
+        throw std::invalid_argument("State has the wrong number of values");
+    }
+}
+
+// Copies external values, if any
+void StateArray::detach()
+{
+    if(external) {
+        values.assign(external, external + n_external);
+        external = nullptr;
+        owner.reset();
+    }
+}
+
+void to_json(nlohmann::json& obj, const StateArray& array)
+{
+    obj = nlohmann::json::array();
+    for(size_t i = 0; i < array.size(); ++i) {
+        obj.push_back(nlohmann::json::array());
+        for(size_t j = 0; j < array.cols(); ++j) {
+            obj[i].push_back(array[i][j]);
+        }
+    }
+}
+
+void from_json(const nlohmann::json& obj, StateArray& array)
+{
+    array = StateArray();
+    array.reserve(obj.size());
+
+    for(auto& row: obj) {
+        StateArray::Row values = array.append(row.size());
+        for(size_t j = 0; j < row.size(); ++j) {
+            values[j] = row[j].is_null() ? NAN : row[j].get<double>();
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "solver/numerics/EigenTypes.hpp"
+#include <nlohmann/json.hpp>
+#include <vector>
+#include <memory>
+
+// Values of a quantity at the nodes of the limb or string for a sequence of states.
+// All values are stored in one contiguous buffer, one row per state, which avoids an allocation per state.
+// The states are accessed as Eigen vector maps, which can be used like VectorXd.
+// Alternatively the values can be external, e.g. in a memory mapped file. They are copied on the first modification,
+// i.e. by adding states or by mut(), but not by reading.
+
+class StateArray
+{
+public:
+    using Row = Eigen::Map<VectorXd>;
+    using ConstRow = Eigen::Map<const VectorXd>;
+
+    StateArray() = default;
+
+    // Refers to external values that are kept alive by the owner
+    StateArray(std::shared_ptr<const void> owner, const double* data, size_t rows, size_t cols);
+
+    size_t size() const;    // Number of states
+    size_t cols() const;    // Number of values per state
+    bool empty() const;
+
+    void reserve(size_t rows);
+
+    // Adds a state with n values and returns it for assignment. The number of values must be the same for all states.
+    Row append(size_t n);
+    void push_back(const Ref<const VectorXd>& values);
+
+    // Adds all states of another array
+    void append(const StateArray& other);
+
+    // Removes all states, keeps the allocated memory
+    void clear();
+
+    ConstRow operator[](size_t i) const;
+    Row mut(size_t i);    // For modification, copies external values
+
+    ConstRow front() const;
+    ConstRow back() const;
+
+    const double* data() const;
+
+private:
+    std::vector<double> values;
+    size_t n_cols = 0;
+    size_t reserved = 0;    // Number of reserved states
+
+    std::shared_ptr<const void> owner;
+    const double* external = nullptr;
+    size_t n_external = 0;
+
+    void set_cols(size_t n);
+    void detach();
+};
+
+// Serialized as an array of arrays, same as std::vector<VectorXd>
+void to_json(nlohmann::json& obj, const StateArray& array);
+void from_json(const nlohmann::json& obj, StateArray& array);
@@ -0,0 +1,163 @@
+#include "StateSink.hpp"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <filesystem>
+#include <memory>
+
+void MemorySink::reserve(size_t n)
+{
+    states.reserve(n);
+}
+
+void MemorySink::write(const BowStates& states)
+{
+    this->states.append(states);
+}
+
+BowStates MemorySink::finish()
+{
+    return std::move(states);
+}
+
+FileSink::FileSink(const std::string& path)
+{
+    BowStates().visit([&](const char* name, const auto&) {
+        paths.push_back(path + "." + name + ".tmp");
+        streams.emplace_back(paths.back(), std::ios::out | std::ios::binary | std::ios::trunc);
+        streams.back().exceptions(~std::ofstream::goodbit);    // Make stream throw exception on failure
+        cols.push_back(1);
+    });
+}
+
+// Removes the files if the states were not finished
+FileSink::~FileSink()
+{
+    if(!streams.empty()) {
+        streams.clear();
+        for(auto& path: paths) {
+            std::error_code error;
+            std::filesystem::remove(path, error);
+        }
+    }
+}
+
+void FileSink::write(const BowStates& states)
+{
+    size_t k = 0;
+    states.visit([&](const char*, const auto& field) {
+        if constexpr(std::is_same_v<std::decay_t<decltype(field)>, StateArray>) {
+            if(!field.empty()) {
+                cols[k] = field.cols();
+            }
+            streams[k].write(reinterpret_cast<const char*>(field.data()), field.size()*field.cols()*sizeof(double));
+        }
+        else {
+            streams[k].write(reinterpret_cast<const char*>(field.data()), field.size()*sizeof(double));
+        }
+        ++k;
+    });
+
+    rows += states.time.size();
+}
+
+BowStates FileSink::finish()
+{
+    using namespace boost::interprocess;
+
+    // Unmaps and removes a file
+    struct MappedFile {
+        std::string path;
+        std::unique_ptr<mapped_region> region;
+
+        ~MappedFile() {
+            region.reset();
+            std::error_code error;
+            std::filesystem::remove(path, error);
+        }
+    };
+
+    streams.clear();    // Closes the files
+
+    BowStates states;
+    size_t k = 0;
+    states.visit([&](const char*, auto& field) {
+        auto file = std::make_shared<MappedFile>();
+        file->path = paths[k];
+
+        if(rows != 0) {
+            file->region = std::make_unique<mapped_region>(file_mapping(paths[k].c_str(), read_only), read_only);
+            const double* data = static_cast<const double*>(file->region->get_address());
+
+            if constexpr(std::is_same_v<std::decay_t<decltype(field)>, StateArray>) {
+                field = StateArray(file, data, rows, cols[k]);
+            }
+            else {
+                field.assign(data, data + rows);
+            }
+        }
+
+        ++k;
+    });
+
+    return states;
+}
+
+StreamSink::StreamSink(StateSink& sink, size_t chunk_size, size_t capacity)
+    : sink(sink),
+      size(chunk_size),
+      queue(capacity),
+      finished(false)
+{
+
+}
+
+void StreamSink::reserve(size_t n)
+{
+    sink.reserve(n);
+}
+
+size_t StreamSink::chunk_size() const
+{
+    return size;
+}
+
+void StreamSink::write(const BowStates& states)
+{
+    sink.write(states);
+
+    pending.append(states);
+    if(queue.try_push(pending)) {
+        pending = BowStates();
+    }
+}
+
+BowStates StreamSink::finish()
+{
+    // Last attempt to publish the pending states, otherwise they are taken by the consumer
+    if(!pending.time.empty() && queue.try_push(pending)) {
+        pending = BowStates();
+    }
+
+    finished.store(true, std::memory_order_release);
+    return sink.finish();
+}
+
+bool StreamSink::read(BowStates& states)
+{
+    BowStates chunk;
+    bool success = false;
+
+    while(queue.try_pop(chunk)) {
+        states.append(chunk);
+        success = true;
+    }
+
+    // The queue is empty and the producer is done, so it can't be modified concurrently anymore
+    if(finished.load(std::memory_order_acquire) && queue.empty() && !pending.time.empty()) {
+        states.append(pending);
+        pending = BowStates();
+        success = true;
+    }
+
+    return success;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "solver/model/output/BowStates.hpp"
+#include "solver/model/output/RingBuffer.hpp"
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Receives the states of a simulation in chunks while it is running.
+// After the simulation, finish() returns all states that were written.
+
+class StateSink
+{
+public:
+    virtual ~StateSink() = default;
+
+    virtual void reserve(size_t n) {}                       // Hint for the expected total number of states
+    virtual size_t chunk_size() const { return 1000; }      // Maximum number of states per write // Magic number
+    virtual void write(const BowStates& states) = 0;
+    virtual BowStates finish() = 0;
+};
+
+// Keeps the states in memory
+class MemorySink: public StateSink
+{
+public:
+    void reserve(size_t n) override;
+    void write(const BowStates& states) override;
+    BowStates finish() override;
+
+private:
+    BowStates states;
+};
+
+// Writes each field of the states to a temporary file <path>.<field>.tmp, which keeps the memory usage bounded.
+// The node values of the finished states refer to the memory mapped files, the scalar values are loaded into memory.
+// The files are removed when they are no longer used by any states.
+class FileSink: public StateSink
+{
+public:
+    FileSink(const std::string& path);
+    ~FileSink();
+
+    void write(const BowStates& states) override;
+    BowStates finish() override;
+
+private:
+    std::vector<std::string> paths;
+    std::vector<std::ofstream> streams;
+    std::vector<size_t> cols;
+    size_t rows = 0;
+};
+
+// Passes the states on to another sink and additionally publishes them to a consumer thread while the simulation is running.
+// States that don't fit into the queue are merged with the next ones, so the simulation never waits for the consumer and no states are lost.
+// States that are still pending at the end of the simulation are handed over by read() once finish() was called.
+class StreamSink: public StateSink
+{
+public:
+    StreamSink(StateSink& sink, size_t chunk_size = 10, size_t capacity = 64);    // Magic numbers
+
+    void reserve(size_t n) override;
+    size_t chunk_size() const override;
+    void write(const BowStates& states) override;
+    BowStates finish() override;
+
+    // Consumer: Appends the published states to the given ones, returns false if there were none
+    bool read(BowStates& states);
+
+private:
+    StateSink& sink;
+    size_t size;
+    BowStates pending;
+    RingBuffer<BowStates> queue;
+    std::atomic<bool> finished;    // Set by the producer after the last write, pending is then owned by the consumer
+};
@@ -0,0 +1,58 @@
+#include "StateSummary.hpp"
+#include <cmath>
+
+StateSummary::StateSummary(const std::vector<LayerProperties>& layers)
+    : stresses(layers)
+{
+
+}
+
+void StateSummary::add(const BowStates& states)
+{
+    // Updates the index of the maximum absolute value, keeps the first one in case of equal values
+    auto update_max_abs = [](double value, unsigned index, double& max_value, unsigned& max_index) {
+        if(index == 0 || std::abs(value) > max_value) {
+            max_value = std::abs(value);
+            max_index = index;
+        }
+    };
+
+    for(size_t i = 0; i < states.time.size(); ++i) {
+        unsigned index = n_states + i;
+
+        if(index == 0) {
+            first_draw_length = states.draw_length[i];
+            first_e_pot = states.e_pot_limbs[i] + states.e_pot_string[i];
+        }
+
+        update_max_abs(states.string_force[i], index, max_string_force, max_string_force_index);
+        update_max_abs(states.grip_force[i], index, max_grip_force, max_grip_force_index);
+        update_max_abs(states.draw_force[i], index, max_draw_force, max_draw_force_index);
+
+        if(!arrow_departure_index && states.acc_arrow[i] == 0.0) {
+            arrow_departure_index = index;
+            final_pos_arrow = states.pos_arrow[i];
+            final_vel_arrow = states.vel_arrow[i];
+            final_e_pot_limbs = states.e_pot_limbs[i];
+            final_e_kin_limbs = states.e_kin_limbs[i];
+            final_e_pot_string = states.e_pot_string[i];
+            final_e_kin_string = states.e_kin_string[i];
+            final_e_kin_arrow = states.e_kin_arrow[i];
+        }
+    }
+
+    stresses.add(states.epsilon, states.kappa);
+
+    if(!states.time.empty()) {
+        last_draw_length = states.draw_length.back();
+        last_draw_force = states.draw_force.back();
+        last_e_pot = states.e_pot_limbs.back() + states.e_pot_string.back();
+    }
+
+    n_states += states.time.size();
+}
+
+unsigned StateSummary::size() const
+{
+    return n_states;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "solver/model/output/BowStates.hpp"
+#include "solver/model/output/StressEnvelope.hpp"
+#include <optional>
+#include <utility>
+#include <vector>
+
+// Summary values of a sequence of bow states, like maximum forces and stresses or the point of arrow departure.
+// The states can be added in consecutive chunks, so the summary doesn't need all states to be in memory at once.
+// The state indices refer to the position in the whole sequence.
+
+class StateSummary
+{
+public:
+    StateSummary(const std::vector<LayerProperties>& layers);
+    void add(const BowStates& states);
+
+    unsigned size() const;    // Number of states added so far
+
+    // Values of the first and last state
+    double first_draw_length = 0.0;
+    double first_e_pot = 0.0;    // Potential energy of limbs and string
+    double last_draw_length = 0.0;
+    double last_draw_force = 0.0;
+    double last_e_pot = 0.0;
+
+    // States with the maximum absolute forces
+    unsigned max_string_force_index = 0;
+    unsigned max_grip_force_index = 0;
+    unsigned max_draw_force_index = 0;
+
+    // First state with zero arrow acceleration, i.e. after the arrow has left the string
+    std::optional<unsigned> arrow_departure_index;
+    double final_pos_arrow = 0.0;
+    double final_vel_arrow = 0.0;
+    double final_e_pot_limbs = 0.0;
+    double final_e_kin_limbs = 0.0;
+    double final_e_pot_string = 0.0;
+    double final_e_kin_string = 0.0;
+    double final_e_kin_arrow = 0.0;
+
+    // Stress extrema per layer
+    StressEnvelope stresses;
+
+private:
+    unsigned n_states = 0;
+
+    double max_string_force = 0.0;
+    double max_grip_force = 0.0;
+    double max_draw_force = 0.0;
+};
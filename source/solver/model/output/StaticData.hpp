@@ -22,9 +22,9 @@ struct StaticData
     std::vector<std::pair<unsigned, unsigned>> max_stress_index;
 };
 
+// The states are serialized separately, see OutputData
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
         StaticData,
-        states,
         final_draw_force,
         drawing_work,
         energy_storage_factor,
@@ -0,0 +1,127 @@
+#include "StressEnvelope.hpp"
+#include <algorithm>
+#include <thread>
+
+StressEnvelope::StressEnvelope(const std::vector<LayerProperties>& layers, bool per_node)
+    : layers(layers),
+      extrema(layers.size()),
+      per_node(per_node)
+{
+
+}
+
+void StressEnvelope::add(const StateArray& epsilon, const StateArray& kappa)
+{
+    const size_t min_states = 1000;    // Minimum number of states per thread // Magic number
+    size_t n = epsilon.size();
+
+    size_t n_threads = std::clamp<size_t>(n/min_states, 1, std::max(std::thread::hardware_concurrency(), 1u));
+    std::vector<std::vector<Extrema>> partial(n_threads);
+
+    std::vector<std::thread> workers;
+    for(size_t t = 1; t < n_threads; ++t) {
+        workers.emplace_back([&, t]{
+            evaluate(epsilon, kappa, t*n/n_threads, (t + 1)*n/n_threads, partial[t]);
+        });
+    }
+
+    evaluate(epsilon, kappa, 0, n/n_threads, partial[0]);
+    for(auto& worker: workers) {
+        worker.join();
+    }
+
+    for(auto& result: partial) {
+        merge(result);
+    }
+
+    n_states += n;
+}
+
+const StressEnvelope::Extrema& StressEnvelope::get(size_t layer) const
+{
+    return extrema[layer];
+}
+
+unsigned StressEnvelope::size() const
+{
+    return n_states;
+}
+
+// Evaluates the states [begin, end). The stresses of back and belly are evaluated one state at a time as vector operations.
+// The node index of an extremum is only searched for if the state improves on the current one.
+void StressEnvelope::evaluate(const StateArray& epsilon, const StateArray& kappa, size_t begin, size_t end, std::vector<Extrema>& result) const
+{
+    // First node with the given value, back before belly
+    auto find_node = [](const ArrayXd& back, const ArrayXd& belly, double value) {
+        for(unsigned j = 0; j < back.size(); ++j) {
+            if(back[j] == value || belly[j] == value) {
+                return j;
+            }
+        }
+
+        return 0u;
+    };
+
+    result.resize(layers.size());
+    for(size_t k = 0; k < layers.size(); ++k) {
+        const LayerProperties& layer = layers[k];
+        Extrema& layer_result = result[k];
+
+        if(per_node) {
+            layer_result.node_min = VectorXd::Constant(layer.length.size(), std::numeric_limits<double>::max());
+            layer_result.node_max = VectorXd::Constant(layer.length.size(), std::numeric_limits<double>::lowest());
+        }
+
+        ArrayXd back(layer.length.size());
+        ArrayXd belly(layer.length.size());
+
+        for(size_t i = begin; i < end; ++i) {
+            back = layer.He_back.array()*epsilon[i].array() + layer.Hk_back.array()*kappa[i].array();
+            belly = layer.He_belly.array()*epsilon[i].array() + layer.Hk_belly.array()*kappa[i].array();
+
+            double max = std::max(back.maxCoeff(), belly.maxCoeff());
+            if(max > layer_result.max_value) {
+                layer_result.max_value = max;
+                layer_result.max_index = {n_states + i, find_node(back, belly, max)};
+            }
+
+            double min = std::min(back.minCoeff(), belly.minCoeff());
+            if(min < layer_result.min_value) {
+                layer_result.min_value = min;
+                layer_result.min_index = {n_states + i, find_node(back, belly, min)};
+            }
+
+            if(per_node) {
+                layer_result.node_min = layer_result.node_min.cwiseMin(back.min(belly).matrix());
+                layer_result.node_max = layer_result.node_max.cwiseMax(back.max(belly).matrix());
+            }
+        }
+    }
+}
+
+// Merges the extrema of subsequent states, keeps the current ones in case of equal values
+void StressEnvelope::merge(const std::vector<Extrema>& other)
+{
+    for(size_t k = 0; k < extrema.size(); ++k) {
+        if(other[k].max_value > extrema[k].max_value) {
+            extrema[k].max_value = other[k].max_value;
+            extrema[k].max_index = other[k].max_index;
+        }
+
+        if(other[k].min_value < extrema[k].min_value) {
+            extrema[k].min_value = other[k].min_value;
+            extrema[k].min_index = other[k].min_index;
+        }
+
+        if(per_node) {
+            if(extrema[k].node_min.size() == 0) {
+                extrema[k].node_min = other[k].node_min;
+                extrema[k].node_max = other[k].node_max;
+            }
+            else {
+                extrema[k].node_min = extrema[k].node_min.cwiseMin(other[k].node_min);
+                extrema[k].node_max = extrema[k].node_max.cwiseMax(other[k].node_max);
+            }
+        }
+    }
+}
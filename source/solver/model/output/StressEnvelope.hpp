@@ -0,0 +1,41 @@
+#pragma once
+#include "solver/model/output/StateArray.hpp"
+#include "solver/model/LimbProperties.hpp"
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Minimum and maximum stresses of the limb layers over a sequence of states, back and belly combined.
+// The states can be added in consecutive chunks, the state indices refer to the position in the whole sequence.
+// Large chunks are evaluated on multiple threads, each on a contiguous range of states. The partial results are merged
+// in order of the ranges, so the indices are the same as for a sequential evaluation (the first of equal values).
+
+class StressEnvelope
+{
+public:
+    struct Extrema {
+        double min_value = std::numeric_limits<double>::max();
+        double max_value = std::numeric_limits<double>::lowest();
+        std::pair<unsigned, unsigned> min_index = {0, 0};    // (state, node)
+        std::pair<unsigned, unsigned> max_index = {0, 0};    // (state, node)
+
+        // Minimum and maximum over time at each node, only if enabled
+        VectorXd node_min;
+        VectorXd node_max;
+    };
+
+    StressEnvelope(const std::vector<LayerProperties>& layers, bool per_node = false);
+    void add(const StateArray& epsilon, const StateArray& kappa);
+
+    const Extrema& get(size_t layer) const;
+    unsigned size() const;    // Number of states added so far
+
+private:
+    const std::vector<LayerProperties>& layers;
+    std::vector<Extrema> extrema;
+    unsigned n_states = 0;
+    bool per_node;
+
+    void evaluate(const StateArray& epsilon, const StateArray& kappa, size_t begin, size_t end, std::vector<Extrema>& result) const;
+    void merge(const std::vector<Extrema>& other);
+};
@@ -34,12 +34,24 @@ SplineSegment::SplineSegment(const Point& start, const SplineInput& input) {
     std::vector<double> s(k, start.s);
     t = linspace(0.0, 1.0, k);
 
-    auto dsdt = [&](double t) {
-        return std::hypot(spline_x.deriv1(t), spline_y.deriv1(t));
+    // Evaluate the derivatives at the grid points and the midpoints between them, t_0, t_01, t_1, t_12, ...
+    std::vector<double> t_eval(2*k - 1);
+    for(size_t i = 0; i < k; ++i) {
+        t_eval[2*i] = t[i];
+        if(i < k - 1) {
+            t_eval[2*i + 1] = (t[i] + t[i+1])/2.0;
+        }
+    }
+
+    std::vector<double> dxdt = spline_x.deriv1(t_eval);
+    std::vector<double> dydt = spline_y.deriv1(t_eval);
+
+    auto dsdt = [&](size_t j) {
+        return std::hypot(dxdt[j], dydt[j]);
     };
 
     for(size_t i = 1; i < k; ++i) {
-        s[i] = s[i-1] + (t[i] - t[i-1])/6.0*(dsdt(t[i-1]) + 4.0*dsdt((t[i] + t[i-1])/2.0) + dsdt(t[i]));    // Simpson method
+        s[i] = s[i-1] + (t[i] - t[i-1])/6.0*(dsdt(2*i - 2) + 4.0*dsdt(2*i - 1) + dsdt(2*i));    // Simpson method
     }
 
     spline_t = CubicSpline(s, t);
@@ -0,0 +1,84 @@
+#pragma once
+#include "EigenTypes.hpp"
+#include <Eigen/Eigenvalues>
+#include <stdexcept>
+#include <complex>
+#include <cmath>
+
+// Arnoldi iteration for a single eigenvalue of a general real linear operator,
+// given as a function A(x, y) with arguments const Ref<const VectorXd>& x and VectorXd& y that computes the product y = A*x.
+// Builds an orthonormal basis of the Krylov subspace of dimension m (fewer if it becomes invariant),
+// computes the eigenvalues of the projected Hessenberg matrix (Ritz values) and selects the one with the highest score.
+// Ritz values with a negative score are not considered, which allows restricting the search to e.g. complex eigenvalues.
+// The iteration is restarted with the real and imaginary parts of the selected Ritz vector until the
+// residual norm of the Ritz pair is below rtol relative to the Ritz value.
+// The vector x is the starting vector and is overwritten with the final starting vector,
+// so that it can be used as a starting vector for a subsequent, similar problem.
+// Extreme eigenvalues converge first, so the score should prefer those, like the ones with the largest magnitude.
+// https://en.wikipedia.org/wiki/Arnoldi_iteration
+
+template<class F, class S>
+inline std::complex<double> arnoldi_iteration(const F& A, const S& score, VectorXd& x, unsigned m, double rtol, unsigned restarts) {
+    m = std::min<unsigned>(m, x.size());
+
+    MatrixXd V(x.size(), m + 1);
+    MatrixXd H(m + 1, m);
+    VectorXd w(x.size());
+    Eigen::EigenSolver<MatrixXd> solver;
+
+    for(unsigned r = 0; r <= restarts; ++r) {
+        V.col(0) = x.normalized();
+        H.setZero();
+
+        // Build Krylov basis. Gram-Schmidt is applied twice to maintain orthogonality.
+        unsigned k = m;
+        for(unsigned j = 0; j < m; ++j) {
+            A(V.col(j), w);
+            for(unsigned pass = 0; pass < 2; ++pass) {
+                VectorXd h = V.leftCols(j + 1).transpose()*w;
+                w.noalias() -= V.leftCols(j + 1)*h;
+                H.col(j).head(j + 1) += h;
+            }
+
+            H(j + 1, j) = w.norm();
+            if(H(j + 1, j) <= 1e-12*H.col(j).head(j + 1).norm()) {    // Invariant subspace found // Magic number
+                k = j + 1;
+                H(j + 1, j) = 0.0;
+                break;
+            }
+
+            V.col(j + 1) = w/H(j + 1, j);
+        }
+
+        // Select Ritz value
+        solver.compute(H.topLeftCorner(k, k), true);
+        if(solver.info() != Eigen::Success) {
+            throw std::runtime_error("Arnoldi iteration: Failed to compute eigenvalues of the Hessenberg matrix");
+        }
+
+        int i_best = -1;
+        for(int i = 0; i < solver.eigenvalues().size(); ++i) {
+            double s = score(solver.eigenvalues()[i]);
+            if(s >= 0.0 && (i_best == -1 || s > score(solver.eigenvalues()[i_best]))) {
+                i_best = i;
+            }
+        }
+
+        if(i_best == -1) {
+            throw std::runtime_error("Arnoldi iteration: No suitable eigenvalue found");
+        }
+
+        std::complex<double> theta = solver.eigenvalues()[i_best];
+        Eigen::VectorXcd y = solver.eigenvectors().col(i_best).normalized();
+
+        // Residual norm of the Ritz pair is |h_k+1,k|*|y_k|
+        double residual = std::abs(H(k, k - 1)*y[k - 1]);
+
+        x = V.leftCols(k)*(y.real() + y.imag());
+        if(residual <= rtol*std::abs(theta)) {
+            return theta;
+        }
+    }
+
+    throw std::runtime_error("Arnoldi iteration: Maximum number of restarts exceeded");
+}
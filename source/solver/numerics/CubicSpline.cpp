@@ -1,8 +1,8 @@
 #include "CubicSpline.hpp"
-#include "solver/numerics/FindInterval.hpp"
 #include "solver/numerics/Sorting.hpp"
 #include "solver/numerics/Utils.hpp"
 #include "solver/numerics/TDMatrix.hpp"
+#include <algorithm>
 #include <stdexcept>
 #include <cmath>
 
@@ -94,6 +94,24 @@ CubicSpline::CubicSpline(const std::vector<double>& args, const std::vector<doub
         }
     }
 
+    // Convert values and slopes to polynomial coefficients for Horner evaluation
+    c1.resize(n-1);
+    c2.resize(n-1);
+    c3.resize(n-1);
+    for(size_t i = 0; i < n-1; ++i) {
+        double dx = x[i+1] - x[i];
+        double delta = (y[i+1] - y[i])/dx;
+        c1[i] = m[i];
+        c2[i] = (3.0*delta - 2.0*m[i] - m[i+1])/dx;
+        c3[i] = (m[i] + m[i+1] - 2.0*delta)/(dx*dx);
+    }
+
+    // Build lookup table with one bucket per interval on average
+    buckets.resize(n-1);
+    bucket_scale = (n-1)/(x[n-1] - x[0]);
+    for(size_t j = 0; j < n-1; ++j) {
+        buckets[j] = std::lower_bound(x.begin() + 1, x.end() - 1, x[0] + j/bucket_scale) - (x.begin() + 1);
+    }
 }
 
 std::vector<double> extract_x_values(const std::vector<Vector<2>>& input) {
@@ -132,17 +150,9 @@ const std::vector<double>& CubicSpline::vals() const {
 
 // Extrapolates on out of bounds access
 double CubicSpline::operator()(double arg) const {
-    // TODO: Horner evaluation
-    auto h_00 = [](double t) { return 2*t*t*t - 3*t*t + 1; };
-    auto h_10 = [](double t) { return t*t*t - 2*t*t + t; };
-    auto h_01 = [](double t) { return -2*t*t*t + 3*t*t; };
-    auto h_11 = [](double t) { return t*t*t - t*t; };
-
-    index = find_interval(x, arg, index);
-    double dx = x[index + 1] - x[index];
-    double t = (arg - x[index])/dx;
-
-    return h_00(t)*y[index] + h_10(t)*dx*m[index] + h_01(t)*y[index + 1] + h_11(t)*dx*m[index + 1];
+    size_t i = find_interval(arg);
+    double t = arg - x[i];
+    return y[i] + t*(c1[i] + t*(c2[i] + t*c3[i]));
 }
 
 // Returns default value on out of bounds access
@@ -155,31 +165,61 @@ double CubicSpline::operator()(double arg, double default_value) const {
 }
 
 double CubicSpline::deriv1(double arg) const {
-    // TODO: Horner evaluation
-    auto dhdt_00 = [](double t) { return 6*t*t - 6*t; };
-    auto dhdt_10 = [](double t) { return 3*t*t - 4*t + 1; };
-    auto dhdt_01 = [](double t) { return -6*t*t + 6*t; };
-    auto dhdt_11 = [](double t) { return 3*t*t - 2*t; };
+    size_t i = find_interval(arg);
+    double t = arg - x[i];
+    return c1[i] + t*(2.0*c2[i] + t*3.0*c3[i]);
+}
 
-    index = find_interval(x, arg, index);
-    double dx = x[index + 1] - x[index];
-    double t = (arg - x[index])/dx;
+double CubicSpline::deriv2(double arg) const {
+    size_t i = find_interval(arg);
+    double t = arg - x[i];
+    return 2.0*c2[i] + t*6.0*c3[i];
+}
 
-    return dhdt_00(t)/dx*y[index] + dhdt_10(t)*m[index] + dhdt_01(t)/dx*y[index + 1] + dhdt_11(t)*m[index + 1];
+void CubicSpline::evaluate(const std::vector<double>& args, std::vector<double>* vals, std::vector<double>* deriv1, std::vector<double>* deriv2) const {
+    if(vals != nullptr) {
+        vals->resize(args.size());
+    }
+    if(deriv1 != nullptr) {
+        deriv1->resize(args.size());
+    }
+    if(deriv2 != nullptr) {
+        deriv2->resize(args.size());
+    }
+
+    size_t i = 0;    // Interval of the previous argument, used as a starting point for the next one
+    for(size_t k = 0; k < args.size(); ++k) {
+        i = find_interval(args[k], i);
+        double t = args[k] - x[i];
+
+        if(vals != nullptr) {
+            (*vals)[k] = y[i] + t*(c1[i] + t*(c2[i] + t*c3[i]));
+        }
+        if(deriv1 != nullptr) {
+            (*deriv1)[k] = c1[i] + t*(2.0*c2[i] + t*3.0*c3[i]);
+        }
+        if(deriv2 != nullptr) {
+            (*deriv2)[k] = 2.0*c2[i] + t*6.0*c3[i];
+        }
+    }
 }
 
-double CubicSpline::deriv2(double arg) const {
-    // TODO: Horner evaluation
-    auto dhdt2_00 = [](double t) { return 12*t - 6; };
-    auto dhdt2_10 = [](double t) { return 6*t - 4; };
-    auto dhdt2_01 = [](double t) { return -12*t + 6; };
-    auto dhdt2_11 = [](double t) { return 6*t - 2; };
+std::vector<double> CubicSpline::operator()(const std::vector<double>& args) const {
+    std::vector<double> vals;
+    evaluate(args, &vals);
+    return vals;
+}
 
-    index = find_interval(x, arg, index);
-    double dx = x[index + 1] - x[index];
-    double t = (arg - x[index])/dx;
+std::vector<double> CubicSpline::deriv1(const std::vector<double>& args) const {
+    std::vector<double> vals;
+    evaluate(args, nullptr, &vals);
+    return vals;
+}
 
-    return dhdt2_00(t)/(dx*dx)*y[index] + dhdt2_10(t)/dx*m[index] + dhdt2_01(t)/(dx*dx)*y[index + 1] + dhdt2_11(t)/dx*m[index + 1];
+std::vector<double> CubicSpline::deriv2(const std::vector<double>& args) const {
+    std::vector<double> vals;
+    evaluate(args, nullptr, nullptr, &vals);
+    return vals;
 }
 
 double CubicSpline::arg_min() const {
@@ -189,3 +229,43 @@ double CubicSpline::arg_min() const {
 double CubicSpline::arg_max() const {
     return x.back();
 }
+
+// Returns an index i such that x[i] < arg <= x[i+1], or the first or last interval if the argument is out of bounds.
+// Looks up the first interval of the argument's bucket and searches forward from there, which takes only a few steps
+// unless the arguments of the spline are very unevenly spaced.
+size_t CubicSpline::find_interval(double arg) const {
+    size_t n = x.size();
+    if(!(arg > x[1])) {
+        return 0;    // Also for NaN
+    }
+    if(arg > x[n-2]) {
+        return n-2;
+    }
+
+    size_t i = buckets[std::min(size_t((arg - x[0])*bucket_scale), buckets.size() - 1)];
+    while(i > 0 && arg <= x[i]) {
+        --i;    // Only in case of rounding errors at the bucket bounds
+    }
+    while(arg > x[i+1]) {
+        ++i;
+    }
+
+    return i;
+}
+
+// Same as above, but checks the given interval and the following one first.
+size_t CubicSpline::find_interval(double arg, size_t hint) const {
+    size_t n = x.size();
+    auto contains = [&](size_t i) {
+        return (i == 0 || x[i] < arg) && (i == n-2 || arg <= x[i+1]);
+    };
+
+    if(contains(hint)) {
+        return hint;
+    }
+    if(hint < n-2 && contains(hint + 1)) {
+        return hint + 1;
+    }
+
+    return find_interval(arg);
+}
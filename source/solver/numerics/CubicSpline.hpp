@@ -4,6 +4,7 @@
 
 // Cubic spline that preserves monotonicity of the input data
 // Throws std::invalid_argument on invalid input
+// The spline has no mutable state, so a single instance can be evaluated by multiple threads at the same time.
 
 enum class BoundaryType {
     FIRST_DERIVATIVE,
@@ -32,13 +33,32 @@ public:
     double deriv1(double arg) const;
     double deriv2(double arg) const;
 
+    // Evaluation at multiple arguments, which may be in any order but are processed faster if they are sorted.
+    // The results are written to the given vectors, which are resized if necessary. Any of them can be nullptr if not needed.
+    void evaluate(const std::vector<double>& args, std::vector<double>* vals, std::vector<double>* deriv1 = nullptr, std::vector<double>* deriv2 = nullptr) const;
+
+    std::vector<double> operator()(const std::vector<double>& args) const;
+    std::vector<double> deriv1(const std::vector<double>& args) const;
+    std::vector<double> deriv2(const std::vector<double>& args) const;
+
     double arg_min() const;
     double arg_max() const;
 
 private:
-    mutable size_t index = 0;    // Interval index of last evaluation
+    size_t find_interval(double arg) const;
+    size_t find_interval(double arg, size_t hint) const;
 
     std::vector<double> x;
     std::vector<double> y;
     std::vector<double> m;
+
+    // Polynomial coefficients of each interval i, y(arg) = y[i] + c1[i]*t + c2[i]*t^2 + c3[i]*t^3 with t = arg - x[i]
+    std::vector<double> c1;
+    std::vector<double> c2;
+    std::vector<double> c3;
+
+    // Lookup table for finding intervals: The argument range is divided into equally sized buckets
+    // and buckets[j] is the first interval that overlaps bucket j
+    std::vector<size_t> buckets;
+    double bucket_scale;    // Number of buckets per unit argument
 };
@@ -1,5 +1,6 @@
 #pragma once
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
 template<size_t n, size_t k = n>
 using Matrix = Eigen::Matrix<double, n, k>;
@@ -11,6 +12,7 @@ template<std::size_t n>
 using Vector = Eigen::Matrix<double, n, 1>;
 
 using Eigen::MatrixXd;
+using SparseMatrixXd = Eigen::SparseMatrix<double>;
 using Eigen::VectorXd;
 using Eigen::ArrayXd;
 using Eigen::Ref;
@@ -30,3 +30,35 @@ inline double golden_section_search(const F& f, double xa, double xb, double xto
 
     throw std::runtime_error("Golden section search: Maximum number of iterations exceeded");
 }
+
+// Backtracking line search for decreasing a non-negative merit function f on the interval (0, 1], starting with the full step x = 1.
+// The step is multiplied by the factor beta until it achieves the sufficient decrease f(x) <= (1 - c*x)*f0 relative to f0 = f(0).
+// This is the Armijo condition for a search direction along which f decreases with slope -f0, like a Newton step does for the norm of the residual.
+// Returns the accepted step or zero if no step was accepted within the maximum number of iterations.
+// See https://en.wikipedia.org/wiki/Backtracking_line_search
+
+template<class F>
+inline double backtracking_search(const F& f, double f0, double c, double beta, unsigned iter) {
+    double x = 1.0;
+    for(unsigned i = 0; i < iter; ++i) {
+        if(f(x) <= (1.0 - c*x)*f0) {
+            return x;
+        }
+
+        x *= beta;
+    }
+
+    return 0.0;
+}
+
+// Backtracking line search as above, but falls back to a golden section search on the interval [0, 1] if no step is accepted.
+
+template<class F>
+inline double backtracking_golden_section_search(const F& f, double f0, double c, double beta, unsigned iter, double xtol, unsigned golden_iter) {
+    double x = backtracking_search(f, f0, c, beta, iter);
+    if(x == 0.0) {
+        return golden_section_search(f, 0.0, 1.0, xtol, golden_iter);
+    }
+
+    return x;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "EigenTypes.hpp"
+#include <cmath>
+
+struct PowerIterationResult {
+    double lambda;      // Rayleigh quotient of the final eigenvector estimate
+    double residual;    // Norm of A*x - lambda*x, for symmetric A there is an eigenvalue within lambda +- residual
+    bool converged;     // Whether the residual reached the tolerance within the maximum number of iterations
+};
+
+// Power iteration for the eigenvalue of largest magnitude of a symmetric linear operator,
+// given as a function A(x, y) that computes the product y = A*x.
+// The vector x is the starting vector and is overwritten with the normalized eigenvector estimate,
+// so that it can be used as a starting vector for a subsequent, similar problem.
+// The iteration stops when the residual norm ||A*x - lambda*x|| is below rtol*|lambda|.
+// Unlike the change of the Rayleigh quotient, which can stall well below the largest eigenvalue if the highest eigenvalues
+// are close together, the residual bounds the distance of lambda to an actual eigenvalue.
+// https://en.wikipedia.org/wiki/Power_iteration
+
+template<class F>
+inline PowerIterationResult power_iteration(const F& A, VectorXd& x, double rtol, unsigned iter) {
+    VectorXd y(x.size());
+    PowerIterationResult result = { 0.0, 0.0, false };
+
+    x.normalize();
+    for(unsigned i = 0; i < iter; ++i) {
+        A(x, y);
+
+        result.lambda = x.dot(y);    // Rayleigh quotient
+        result.residual = (y - result.lambda*x).norm();
+
+        double norm = y.norm();
+        if(norm == 0.0) {
+            result.converged = true;
+            return result;
+        }
+
+        x = y/norm;
+        if(result.residual <= rtol*std::abs(result.lambda)) {
+            result.converged = true;
+            return result;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,94 @@
+#include "solver/fem/System.hpp"
+#include "solver/fem/DynamicSolver.hpp"
+#include "solver/fem/elements/BarElement.hpp"
+#include "solver/fem/elements/MassElement.hpp"
+#include <catch2/catch.hpp>
+
+// Compares the in-place implementation of DynamicSolver with a straightforward one based on vector expressions.
+// Both have to produce identical results.
+TEST_CASE("central-difference-reference")
+{
+    auto create_system = [](System& system) {
+        double L = 1.0;
+        double EA = 5000.0;
+        double etaA = 20.0;
+
+        Node node_a = system.create_node({false, false, false}, {0.0, 0.0, 0.0});
+        Node node_b = system.create_node({ true,  true, false}, {  L, 0.0, 0.0});
+        Node node_c = system.create_node({ true,  true, false}, {  L,   L, 0.0});
+
+        system.mut_elements().add(BarElement(system, node_a, node_b, L, EA, etaA, 0.0));
+        system.mut_elements().add(BarElement(system, node_b, node_c, 0.9*L, EA, etaA, 0.0));
+        system.mut_elements().add(MassElement(system, node_b, 1.0, 0.0));
+        system.mut_elements().add(MassElement(system, node_c, 2.0, 0.0));
+
+        system.set_p(node_c.x, 5.0);
+        system.set_p(node_c.y, -10.0);
+    };
+
+    double dt = 1e-4;
+    unsigned steps = 5000;
+
+    System system_num;
+    create_system(system_num);
+    DynamicSolver solver(system_num, dt, 1.0/dt, [&]{ return false; });
+
+    System system_ref;
+    create_system(system_ref);
+    VectorXd u_p2 = system_ref.get_u() - dt*system_ref.get_v() + dt*dt/2.0*system_ref.get_a();
+
+    for(unsigned i = 0; i < steps; ++i) {
+        solver.step();
+
+        VectorXd u_p1 = system_ref.get_u();
+        system_ref.set_u(2.0*system_ref.get_u() - u_p2 + dt*dt*system_ref.get_a());
+        system_ref.set_v((1.5*system_ref.get_u() - 2.0*u_p1 + 0.5*u_p2)/dt);
+        system_ref.set_t(system_ref.get_t() + dt);
+        u_p2 = u_p1;
+
+        REQUIRE(system_num.get_t() == system_ref.get_t());
+        REQUIRE(system_num.get_u() == system_ref.get_u());
+        REQUIRE(system_num.get_v() == system_ref.get_v());
+        REQUIRE(system_num.get_a() == system_ref.get_a());
+    }
+
+    REQUIRE(system_num.get_u().cwiseAbs().maxCoeff() > 0.0);
+}
+
+// Undamped harmonic oscillator with a spring that stiffens over time, simulated with adaptive timestep.
+// The timestep has to follow the natural frequency of the system.
+TEST_CASE("central-difference-adaptive-timestep")
+{
+    double l = 1.0;
+    double k = 100.0;
+    double m = 5.0;
+    double s0 = 0.1;
+    double factor = 0.1;
+
+    System system;
+    Node node_a = system.create_node({ false, false, false }, {    0.0, 0.0, 0.0 });
+    Node node_b = system.create_node({ true, false, false },  { l + s0, 0.0, 0.0 });
+
+    system.mut_elements().add(BarElement(system, node_a, node_b, l, l*k, 0.0, 0.0));
+    system.mut_elements().add(MassElement(system, node_b, m, 0.0));
+
+    double omega = std::sqrt(k/m);
+    double T = 2.0*M_PI/omega;
+
+    DynamicSolver solver(system, DynamicSolver::AdaptiveTimestep{factor}, 10.0, [&]{ return system.get_t() >= T; });
+    REQUIRE(solver.get_timestep() <= factor*2.0/omega);
+    REQUIRE(solver.get_timestep() >= 0.5*factor*2.0/omega);
+
+    while(solver.step())
+    {
+        double s_num = system.get_u(node_b.x) - l;
+        double s_ref = s0*std::cos(omega*system.get_t());
+        REQUIRE(std::abs(s_num - s_ref) < 1e-3);
+    }
+
+    // Stiffen the spring by a factor of 4, which doubles the natural frequency
+    system.mut_elements().front<BarElement>("").set_stiffness(4.0*l*k);
+    solver.step();
+
+    REQUIRE(solver.get_timestep() <= factor*1.0/omega);
+}
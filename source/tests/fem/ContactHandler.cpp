@@ -0,0 +1,41 @@
+#include "solver/fem/System.hpp"
+#include "solver/fem/elements/ContactHandler.hpp"
+#include <catch2/catch.hpp>
+
+TEST_CASE("contact-handler-broadphase")
+{
+    System system;
+    Node node_a = system.create_node({false, false, false}, {0.0, 0.0, 0.0});
+    Node node_b = system.create_node({false, false, false}, {1.0, 0.0, 0.0});
+    Node node_c = system.create_node({true, true, false}, {0.5, 1.0, 0.0});
+
+    ContactHandler handler(system, ContactForce(1000.0, 0.01));
+    handler.add_segment(node_a, node_b, 0.1, 0.1);
+    handler.add_point(node_c);
+    system.mut_elements().add(handler, "contact");
+
+    const ContactHandler& contact = system.get_elements().front<ContactHandler>("contact");
+
+    // Point outside of the bounding box of the segment
+    system.get_K();
+    system.get_q();
+    ContactHandler::Counts counts = contact.get_counts();
+    REQUIRE(counts.active == 0);
+    REQUIRE(counts.updates == 1);
+    REQUIRE(counts.skipped == 1);    // Stiffness and forces share the broadphase for the same displacements
+
+    // Point moves into the bounding box
+    system.mut_u()(node_c.y.index) = 0.05;
+    system.get_q();
+    counts = contact.get_counts() - counts;
+    REQUIRE(counts.active == 1);
+    REQUIRE(counts.updates == 1);
+    REQUIRE(counts.swaps == 1);
+    REQUIRE(counts.added == 1);
+
+    // Point moves out again
+    system.mut_u()(node_c.y.index) = 1.0;
+    system.get_q();
+    REQUIRE(contact.get_counts().active == 0);
+    REQUIRE(contact.get_counts().removed == 1);
+}
@@ -0,0 +1,66 @@
+#include "solver/fem/Dependency.hpp"
+#include "solver/fem/System.hpp"
+#include "solver/fem/DynamicSolver.hpp"
+#include "solver/fem/elements/BarElement.hpp"
+#include "solver/fem/elements/MassElement.hpp"
+#include <catch2/catch.hpp>
+
+TEST_CASE("dependency-lazy-evaluation")
+{
+    // Chain c = 2*b, b = a + 1
+    Independent<int> a(1);
+    Dependent<int> b;
+    Dependent<int> c;
+
+    b.depends_on(a);
+    b.on_update([&]{ b.mut() = a.get() + 1; });
+
+    c.depends_on(b);
+    c.on_update([&]{ c.mut() = 2*b.get(); });
+
+    REQUIRE(c.get() == 4);
+    REQUIRE(b.get_updates() == 1);
+    REQUIRE(c.get_updates() == 1);
+
+    // No recomputation without modification
+    REQUIRE(c.get() == 4);
+    REQUIRE(c.get_updates() == 1);
+
+    // Multiple modifications, single recomputation of the whole chain
+    a.mut() = 2;
+    a.mut() = 3;
+    REQUIRE(!c.is_valid());
+    REQUIRE(c.get() == 8);
+    REQUIRE(b.get_updates() == 2);
+    REQUIRE(c.get_updates() == 2);
+
+    // Explicit invalidation
+    c.set_valid(false);
+    REQUIRE(c.get() == 8);
+    REQUIRE(b.get_updates() == 2);
+    REQUIRE(c.get_updates() == 3);
+}
+
+TEST_CASE("dependency-system-update-counts")
+{
+    System system;
+    Node node_a = system.create_node({ false, false, false }, { 0.0, 0.0, 0.0 });
+    Node node_b = system.create_node({ true, false, false },  { 1.1, 0.0, 0.0 });
+
+    system.mut_elements().add(BarElement(system, node_a, node_b, 1.0, 100.0, 1.0, 0.0));
+    system.mut_elements().add(MassElement(system, node_b, 1.0, 0.0));
+
+    system.get_a();
+    System::UpdateCounts before = system.get_update_counts();
+
+    // The central difference method only needs the internal forces, once per substep
+    DynamicSolver solver(system, 1e-3, 100.0, [&]{ return false; });
+    solver.step();
+
+    System::UpdateCounts counts = system.get_update_counts() - before;
+    REQUIRE(counts.q == 9);    // Ten substeps, the first one starts from the already evaluated initial state
+    REQUIRE(counts.a == 0);
+    REQUIRE(counts.M == 0);
+    REQUIRE(counts.K == 0);
+    REQUIRE(counts.D == 0);
+}
@@ -0,0 +1,99 @@
+#include "solver/fem/System.hpp"
+#include "solver/fem/EigenvalueSolver.hpp"
+#include "solver/fem/elements/BeamElement.hpp"
+#include <Eigen/Eigenvalues>
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <vector>
+
+// Compares the extreme modes of a damped cantilever beam with the ones obtained
+// by solving the full linearized eigenvalue problem with a dense solver
+TEST_CASE("damped-cantilever-extreme-modes")
+{
+    unsigned N = 20;    // Number of elements
+
+    double L = 0.8;
+    double b = 0.03;
+    double h = 0.01;
+    double E = 12e9;
+    double rho = 700.0;
+
+    double I = b*h*h*h/12.0;
+    double A = b*h;
+
+    System system;
+    std::vector<Node> nodes;
+
+    for(unsigned i = 0; i < N+1; ++i)
+    {
+        bool active = (i != 0);
+        nodes.push_back(system.create_node({active, active, active}, {double(i)/double(N)*L, 0.0, 0.0}));
+    }
+
+    for(unsigned i = 0; i < N; ++i)
+    {
+        BeamElement element(system, nodes[i], nodes[i+1], rho*A, L/double(N));
+        element.set_stiffness(E*A, E*I, 0.0);
+        system.mut_elements().add(element);
+    }
+
+    // Reference solution
+    auto compute_reference = [&]() {
+        size_t n = system.dofs();
+        MatrixXd K = system.get_K();
+        MatrixXd D = system.get_D();
+        MatrixXd A(2*n, 2*n);
+        MatrixXd B(2*n, 2*n);
+
+        A << MatrixXd::Zero(n, n), K,
+             K, D;
+
+        B << K, MatrixXd::Zero(n, n),
+             MatrixXd::Zero(n, n), -system.get_M().asDiagonal().toDenseMatrix();
+
+        Eigen::GeneralizedEigenSolver<MatrixXd> solver(A, B, false);
+        REQUIRE(solver.info() == Eigen::Success);
+
+        std::vector<ModeInfo> modes;
+        for(int i = 0; i < solver.eigenvalues().size(); ++i) {
+            if(solver.eigenvalues()[i].imag() > 0.0) {
+                modes.push_back(ModeInfo(solver.eigenvalues()[i]));
+            }
+        }
+
+        auto by_omega = [](const ModeInfo& a, const ModeInfo& b) { return a.omega < b.omega; };
+        return std::make_pair(*std::min_element(modes.begin(), modes.end(), by_omega),
+                              *std::max_element(modes.begin(), modes.end(), by_omega));
+    };
+
+    EigenvalueSolver solver(system);
+
+    // Lowest undamped mode
+    {
+        Eigen::GeneralizedSelfAdjointEigenSolver<MatrixXd> reference(MatrixXd(system.get_K()), system.get_M().asDiagonal(), Eigen::EigenvaluesOnly);
+        REQUIRE(reference.info() == Eigen::Success);
+
+        ModeShape mode = solver.compute_minimum_undamped_mode();
+        VectorXd residual = system.get_K()*mode.phi - mode.omega*mode.omega*system.get_M().cwiseProduct(mode.phi);
+
+        REQUIRE(mode.omega == Approx(std::sqrt(reference.eigenvalues().minCoeff())).epsilon(1e-8));
+        REQUIRE(mode.phi.dot(system.get_M().cwiseProduct(mode.phi)) == Approx(1.0).epsilon(1e-12));
+        REQUIRE(residual.norm() < 1e-4*mode.omega*mode.omega*system.get_M().cwiseProduct(mode.phi).norm());
+    }
+
+    for(double beta: {0.0, 1.0, 5.0, 20.0})
+    {
+        for(auto& element: system.mut_elements().group<BeamElement>("")) {
+            element.set_damping(beta);
+        }
+
+        auto [mode_min_ref, mode_max_ref] = compute_reference();
+        ModeInfo mode_min = solver.compute_minimum_frequency();
+        ModeInfo mode_max = solver.compute_maximum_frequency();
+
+        REQUIRE(mode_min.omega == Approx(mode_min_ref.omega).epsilon(1e-8));
+        REQUIRE(mode_min.zeta == Approx(mode_min_ref.zeta).margin(1e-8));
+        REQUIRE(mode_max.omega == Approx(mode_max_ref.omega).epsilon(1e-6));
+        REQUIRE(mode_max.zeta == Approx(mode_max_ref.zeta).margin(1e-6));
+    }
+}
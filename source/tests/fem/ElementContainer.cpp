@@ -0,0 +1,33 @@
+#include "solver/fem/System.hpp"
+#include "solver/fem/elements/BarElement.hpp"
+#include "solver/fem/elements/MassElement.hpp"
+#include <catch2/catch.hpp>
+
+TEST_CASE("element-container-groups")
+{
+    System system;
+    Node node_a = system.create_node({ false, false, false }, { 0.0, 0.0, 0.0 });
+    Node node_b = system.create_node({ true, false, false },  { 1.0, 0.0, 0.0 });
+    Node node_c = system.create_node({ true, false, false },  { 2.0, 0.0, 0.0 });
+
+    // Elements of different types interleaved across two groups
+    ElementContainer& elements = system.mut_elements();
+    elements.add(BarElement(system, node_a, node_b, 1.0, 100.0, 0.0, 0.0), "bars");
+    elements.add(MassElement(system, node_b, 1.0, 0.0), "masses");
+    elements.add(BarElement(system, node_b, node_c, 0.5, 200.0, 0.0, 0.0), "bars");
+    elements.add(MassElement(system, node_c, 2.0, 0.0), "masses");
+
+    // Elements of a group keep the order of their addition
+    REQUIRE(elements.group<BarElement>("bars").size() == 2);
+    REQUIRE(elements.group<MassElement>("bars").size() == 0);
+    REQUIRE(elements.group<BarElement>("none").size() == 0);
+    REQUIRE(elements.front<BarElement>("bars").get_length() == 1.0);
+    REQUIRE(elements.back<BarElement>("bars").get_length() == 0.5);
+
+    // Group energies only include the elements of the group
+    system.mut_u()(node_c.x.index) = 2.1;
+    system.mut_v()(node_c.x.index) = 3.0;
+    REQUIRE(elements.get_potential_energy("bars") == Approx(0.5*200.0/0.5*0.6*0.6));
+    REQUIRE(elements.get_kinetic_energy("masses") == Approx(0.5*2.0*3.0*3.0));
+    REQUIRE(elements.get_potential_energy("masses") == 0.0);
+}
@@ -58,6 +58,81 @@ TEST_CASE("large-deformation-cantilever")
     REQUIRE(std::abs((uy_num - uy_ref)/uy_ref) < 5.79e-4);
 }
 
+TEST_CASE("large-deformation-cantilever-strategies")
+{
+    // Same problem as above, solved in several load steps with the different iteration strategies of the static solver.
+    // All strategies must arrive at the same solution, the ones that reuse factorizations with less of them.
+    // The backtracking line search must need less residual evaluations than the golden section search.
+
+    unsigned N = 15;
+
+    double L = 2.0;
+    double b = 0.1;
+    double h = 0.1;
+
+    double I = b*h*h*h/12.0;
+    double A = b*h;
+    double E = 2.07e11;
+
+    double F0 = 3.0*E*I/(L*L);
+
+    auto solve = [&](StaticSolver::Strategy strategy, unsigned& iterations, unsigned& factorizations, unsigned& evaluations) {
+        System system;
+        std::vector<Node> nodes;
+
+        for(unsigned i = 0; i < N+1; ++i)
+        {
+            bool active = (i != 0);
+            nodes.push_back(system.create_node({active, active, active}, {double(i)/double(N)*L, 0.0, 0.0}));
+        }
+
+        for(unsigned i = 0; i < N; ++i)
+        {
+            BeamElement element(system, nodes[i], nodes[i+1], 0.0, L/double(N));
+            element.set_stiffness(E*A, E*I, 0.0);
+            system.mut_elements().add(element);
+        }
+
+        iterations = 0;
+        factorizations = 0;
+        evaluations = 0;
+
+        StaticSolverLC solver(system, strategy);
+        for(unsigned i = 1; i <= 10; ++i)
+        {
+            system.set_p(nodes[N].y, 0.1*i*F0);
+            StaticSolver::Info info = solver.solve();
+            REQUIRE(info.outcome == StaticSolver::Info::Success);
+
+            REQUIRE(info.evaluations > info.iterations);    // Initial residual and at least one per iteration
+
+            iterations += info.iterations;
+            factorizations += info.factorizations;
+            evaluations += info.evaluations;
+        }
+
+        return Vector<2>{L - system.get_u(nodes[N].x), system.get_u(nodes[N].y)};
+    };
+
+    unsigned iterations, factorizations, evaluations;
+
+    Vector<2> u_newton = solve({StaticSolver::Strategy::FullNewton}, iterations, factorizations, evaluations);
+    REQUIRE(factorizations == iterations);
+    unsigned evaluations_backtracking = evaluations;
+
+    Vector<2> u_golden = solve({StaticSolver::Strategy::FullNewton, 10, StaticSolver::Strategy::GoldenSection}, iterations, factorizations, evaluations);
+    REQUIRE(evaluations > evaluations_backtracking);
+    REQUIRE((u_golden - u_newton).norm() < 1e-4*u_newton.norm());
+
+    Vector<2> u_modified = solve({StaticSolver::Strategy::ModifiedNewton, 5}, iterations, factorizations, evaluations);
+    REQUIRE(factorizations < iterations);
+    REQUIRE((u_modified - u_newton).norm() < 1e-4*u_newton.norm());
+
+    Vector<2> u_bfgs = solve({StaticSolver::Strategy::BFGS, 5}, iterations, factorizations, evaluations);
+    REQUIRE(factorizations < iterations);
+    REQUIRE((u_bfgs - u_newton).norm() < 1e-4*u_newton.norm());
+}
+
 TEST_CASE("large-deformation-circular-beam")
 {
     /*
@@ -0,0 +1,47 @@
+#include "solver/fem/Profiler.hpp"
+#include <nlohmann/json.hpp>
+#include <catch2/catch.hpp>
+
+TEST_CASE("profiler-scopes-and-counters")
+{
+    Profiler profiler;
+    REQUIRE(Profiler::active() == nullptr);
+
+    // Scopes without an active profiler have no effect
+    {
+        ProfileScope scope("ignored");
+    }
+
+    {
+        Profiler::Activation activation(profiler);
+        REQUIRE(Profiler::active() == &profiler);
+
+        for(int i = 0; i < 3; ++i) {
+            ProfileScope outer("outer");
+            profiler.count("iterations", 2);
+            {
+                ProfileScope inner("inner");
+                profiler.count("evaluations", 1);
+            }
+        }
+        profiler.count("total", 5);
+    }
+
+    REQUIRE(Profiler::active() == nullptr);
+
+    auto& timers = profiler.get_timers();
+    REQUIRE(timers.size() == 2);
+    REQUIRE(timers.at("outer").calls == 3);
+    REQUIRE(timers.at("outer/inner").calls == 3);
+    REQUIRE(timers.at("outer").time >= timers.at("outer/inner").time);
+
+    auto& counters = profiler.get_counters();
+    REQUIRE(counters.size() == 3);
+    REQUIRE(counters.at("outer/iterations") == 6);
+    REQUIRE(counters.at("outer/inner/evaluations") == 3);
+    REQUIRE(counters.at("total") == 5);
+
+    nlohmann::json obj = profiler;
+    REQUIRE(obj["timers"]["outer/inner"]["calls"] == 3);
+    REQUIRE(obj["counters"]["total"] == 5);
+}
@@ -101,7 +101,6 @@ TEST_CASE("tangent-stiffness-beam-element")
 
 TEST_CASE("tangent-stiffness-contact-element")
 {
-    /*
     auto check_at = [](double x0, double y0, double phi0, double x1, double y1, double phi1, double x2, double y2)
     {
         double EA = 100.0;
@@ -120,5 +119,44 @@ TEST_CASE("tangent-stiffness-contact-element")
 
     check_at(0.0, 0.0, M_PI_2, 0.0, 1.0, M_PI_2, 1.25, 0.5);  // No contact
     check_at(0.0, 0.0, M_PI_2, 0.0, 1.0, M_PI_2, 0.25, 0.5);  // Contact
-    */
+}
+
+// Internal forces of several beam elements (evaluated in a batch) must be the gradient of their potential energy
+TEST_CASE("internal-forces-beam-elements")
+{
+    System system;
+    std::vector<Node> nodes;
+    for(int i = 0; i < 5; ++i) {
+        nodes.push_back(system.create_node({true, true, true}, {1.0*i, 0.0, 0.0}));
+    }
+
+    for(int i = 0; i < 4; ++i) {
+        BeamElement element(system, nodes[i], nodes[i+1], 0.0, 1.0);
+        element.set_stiffness(100.0, 10.0, 5.0);
+        element.set_reference_angles(0.1*i, -0.1*i);
+        system.mut_elements().add(element);
+    }
+
+    VectorXd u = 0.1*VectorXd::Random(system.dofs());
+    u += system.get_u();
+    system.set_u(u);
+
+    double h = 1e-6;
+    VectorXd q_num(system.dofs());
+    for(std::size_t i = 0; i < system.dofs(); ++i)
+    {
+        u(i) += h;
+        system.set_u(u);
+        double e_fwd = system.get_elements().get_potential_energy("");
+
+        u(i) -= 2.0*h;
+        system.set_u(u);
+        double e_bwd = system.get_elements().get_potential_energy("");
+
+        u(i) += h;
+        system.set_u(u);
+        q_num(i) = (e_fwd - e_bwd)/(2.0*h);
+    }
+
+    REQUIRE(system.get_q().isApprox(q_num, 1e-6));
 }
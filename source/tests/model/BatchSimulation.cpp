@@ -0,0 +1,83 @@
+#include "solver/model/BatchSimulation.hpp"
+#include <catch2/catch.hpp>
+#include <filesystem>
+
+TEST_CASE("batch-parameter-ranges")
+{
+    ParameterRange list("/string/n_strands=10,12,14");
+    REQUIRE(list.pointer == "/string/n_strands");
+    REQUIRE(list.values == std::vector<double>{10.0, 12.0, 14.0});
+
+    ParameterRange range("/dimensions/draw_length=0.6:0.8:3");
+    REQUIRE(range.pointer == "/dimensions/draw_length");
+    REQUIRE(range.values.size() == 3);
+    REQUIRE(range.values[1] == Approx(0.7));
+
+    REQUIRE_THROWS(ParameterRange("/string/n_strands"));
+    REQUIRE_THROWS(ParameterRange("/string/n_strands=a,b"));
+    REQUIRE_THROWS(ParameterRange("/dimensions/draw_length=0.6:0.8"));
+
+    // Variants for all combinations, the last range varying fastest
+    InputData input;
+    auto variants = create_variants("bow", input, {list, range});
+    REQUIRE(variants.size() == 9);
+    REQUIRE(variants[0].name == "bow_0");
+    REQUIRE(variants[5].name == "bow_5");
+    REQUIRE(variants[5].parameters == std::vector<double>{12.0, range.values[2]});
+    REQUIRE(variants[5].input.string.n_strands == 12);
+    REQUIRE(variants[5].input.dimensions.draw_length == range.values[2]);
+
+    REQUIRE_THROWS(create_variants("bow", input, {ParameterRange("/string/no_such_value=1,2")}));
+    REQUIRE_THROWS(create_variants("bow", input, {ParameterRange("/comment=1,2")}));
+}
+
+TEST_CASE("batch-simulation")
+{
+    InputData input;
+    input.settings.n_draw_steps = 10;
+
+    // Second variant has an invalid draw length
+    auto variants = create_variants("bow", input, {ParameterRange("/dimensions/draw_length=0.7,0.1")});
+
+    std::string directory = std::filesystem::temp_directory_path().string();
+    BatchSimulation simulation(SimulationMode::Static, directory, 2);
+
+    unsigned finished = 0;
+    auto summaries = simulation.run(variants, [&](const BatchSummary& summary) {
+        ++finished;
+    });
+
+    REQUIRE(finished == 2);
+    REQUIRE(summaries.size() == 2);
+
+    // Result of the successful variant must be identical to a single simulation
+    OutputData output = BowModel::simulate(variants[0].input, SimulationMode::Static, [](int, int){});
+    REQUIRE(summaries[0].error.empty());
+    REQUIRE(summaries[0].final_draw_force == output.statics.final_draw_force);
+    REQUIRE(summaries[0].drawing_work == output.statics.drawing_work);
+
+    std::filesystem::path path = std::filesystem::path(directory) / "bow_0.res";
+    REQUIRE(std::filesystem::exists(path));
+    REQUIRE(OutputData(path.string()).statics.final_draw_force == output.statics.final_draw_force);
+    std::filesystem::remove(path);
+
+    REQUIRE(!summaries[1].error.empty());
+}
+
+TEST_CASE("batch-duplicate-names")
+{
+    // Two input files with the same base name, e.g. a/bow.bow and b/bow.bow
+    InputData input;
+    std::vector<BatchVariant> variants = create_variants("bow", input, {});
+    auto other = create_variants("bow", input, {});
+    variants.insert(variants.end(), other.begin(), other.end());
+
+    std::string directory = std::filesystem::temp_directory_path().string();
+    BatchSimulation simulation(SimulationMode::Static, directory, 2);
+
+    unsigned finished = 0;
+    REQUIRE_THROWS(simulation.run(variants, [&](const BatchSummary& summary) {
+        ++finished;
+    }));
+    REQUIRE(finished == 0);
+}
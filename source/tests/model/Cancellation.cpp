@@ -0,0 +1,48 @@
+#include "solver/model/BowModel.hpp"
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <thread>
+
+TEST_CASE("simulation-cancellation")
+{
+    InputData input;
+    input.settings.n_draw_steps = 10;
+
+    // Canceled during the dynamic simulation by the progress callback
+    MemorySink sink;
+    bool canceled = false;
+    int progress = 0;
+
+    REQUIRE_THROWS_AS(BowModel::simulate(input, SimulationMode::Dynamic, [&](int p1, int p2) {
+        progress = p2;
+        canceled = (p2 > 0);
+    }, sink, [&]{ return canceled; }), SimulationCanceled);
+    REQUIRE(progress > 0);
+    REQUIRE(progress < 100);
+
+    // Canceled from another thread once the simulation has started
+    std::atomic<bool> started = false;
+    std::atomic<bool> cancel = false;
+    std::exception_ptr error;
+
+    std::thread worker([&] {
+        try {
+            MemorySink sink;
+            BowModel::simulate(input, SimulationMode::Dynamic, [&](int, int) {
+                started = true;
+            }, sink, [&]{ return cancel.load(); });
+        }
+        catch(...) {
+            error = std::current_exception();
+        }
+    });
+
+    while(!started) {
+        std::this_thread::yield();
+    }
+    cancel = true;
+    worker.join();
+
+    REQUIRE(error != nullptr);
+    REQUIRE_THROWS_AS(std::rethrow_exception(error), SimulationCanceled);
+}
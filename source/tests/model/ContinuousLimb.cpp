@@ -0,0 +1,52 @@
+#include "solver/model/ContinuousLimb.hpp"
+#include "solver/numerics/Linspace.hpp"
+#include <catch2/catch.hpp>
+
+TEST_CASE("continuous-limb-grid-evaluation")
+{
+    // Limb with a second layer that only covers part of the limb, so that some heights are out of bounds
+    InputData input;
+    input.materials.push_back(Material());
+    input.materials[1].rho = 1200.0;
+    input.materials[1].E = 20e9;
+    input.layers.push_back(Layer());
+    input.layers[1].material = 1;
+    input.layers[1].height = {{0.2, 0.005}, {0.6, 0.004}, {0.9, 0.003}};
+
+    ContinuousLimb limb(input);
+    std::vector<double> s = linspace(0.0, limb.length(), 101);
+
+    // Evaluate twice with the same grid, the results must not depend on previous contents
+    SectionGrid grid;
+    limb.evaluate(linspace(0.0, limb.length(), 11), grid);
+    limb.evaluate(s, grid);
+
+    // Evaluating again at the same number of arc lengths reuses the memory of the grid
+    const double* Cee = grid.Cee.data();
+    const double* y1 = grid.y[1].data();
+    limb.evaluate(s, grid);
+    REQUIRE(grid.Cee.data() == Cee);
+    REQUIRE(grid.y[1].data() == y1);
+
+    REQUIRE(grid.y.size() == 3);
+    for(size_t i = 0; i < s.size(); ++i) {
+        Vector<3> r = limb.get_r(s[i]);
+        REQUIRE(grid.x_pos[i] == Approx(r[0]));
+        REQUIRE(grid.y_pos[i] == Approx(r[1]));
+        REQUIRE(grid.angle[i] == Approx(r[2]));
+
+        REQUIRE(grid.width[i] == Approx(limb.get_w(s[i])));
+        REQUIRE(grid.height[i] == Approx(limb.get_h(s[i])));
+
+        std::vector<double> y = limb.get_y(s[i]);
+        for(size_t j = 0; j < y.size(); ++j) {
+            REQUIRE(grid.y[j][i] == Approx(y[j]).margin(1e-15));
+        }
+
+        Matrix<2, 2> C = limb.get_C(s[i]);
+        REQUIRE(grid.rhoA[i] == Approx(limb.get_rhoA(s[i])));
+        REQUIRE(grid.Cee[i] == Approx(C(0, 0)));
+        REQUIRE(grid.Ckk[i] == Approx(C(1, 1)));
+        REQUIRE(grid.Cek[i] == Approx(C(0, 1)));
+    }
+}
@@ -0,0 +1,154 @@
+#include "solver/model/BowModel.hpp"
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+
+// Compares all states of two outputs
+static void check_states(const BowStates& a, const BowStates& b)
+{
+    std::vector<const std::vector<double>*> scalars_b;
+    std::vector<const StateArray*> arrays_b;
+    b.visit([&](const char*, const auto& field) {
+        if constexpr(std::is_same_v<std::decay_t<decltype(field)>, StateArray>) {
+            arrays_b.push_back(&field);
+        }
+        else {
+            scalars_b.push_back(&field);
+        }
+    });
+
+    size_t i = 0, j = 0;
+    a.visit([&](const char*, const auto& field) {
+        if constexpr(std::is_same_v<std::decay_t<decltype(field)>, StateArray>) {
+            const StateArray& other = *arrays_b[i++];
+            REQUIRE(field.size() == other.size());
+            REQUIRE(field.cols() == other.cols());
+            REQUIRE(std::equal(field.data(), field.data() + field.size()*field.cols(), other.data()));
+        }
+        else {
+            REQUIRE(field == *scalars_b[j++]);
+        }
+    });
+}
+
+TEST_CASE("result-files")
+{
+    InputData input;
+    input.settings.n_draw_steps = 10;
+    OutputData output = BowModel::simulate(input, SimulationMode::Static, [](int, int){});
+
+    for(auto format: {OutputData::Format::Binary, OutputData::Format::MsgPack}) {
+        std::string path = (std::filesystem::temp_directory_path() / "result-files.res").string();
+        output.save(path, format);
+
+        // The loaded result has to be released before removing the file, since Windows can't delete mapped files
+        {
+            OutputData loaded(path);
+            REQUIRE(loaded.version == output.version);
+            REQUIRE(loaded.setup.string_length == output.setup.string_length);
+            REQUIRE(loaded.statics.final_draw_force == output.statics.final_draw_force);
+            REQUIRE(loaded.statics.max_stress_index == output.statics.max_stress_index);
+            REQUIRE(loaded.dynamics.states.time.empty());
+            check_states(loaded.statics.states, output.statics.states);
+
+            // Reading a loaded state array keeps referring to its values, modifying it copies them
+            const double* mapped = loaded.statics.states.kappa.data();
+            REQUIRE(loaded.statics.states.kappa[0][0] == output.statics.states.kappa[0][0]);
+            REQUIRE(loaded.statics.states.kappa.data() == mapped);
+
+            loaded.statics.states.kappa.mut(0)[0] = 1.0;
+            REQUIRE(loaded.statics.states.kappa[0][0] == 1.0);
+            REQUIRE(loaded.statics.states.kappa[1] == output.statics.states.kappa[1]);
+        }
+
+        std::filesystem::remove(path);
+    }
+
+    REQUIRE_THROWS(OutputData("no/such/file.res"));
+}
+
+TEST_CASE("result-files-overwrite")
+{
+    InputData input;
+    input.settings.n_draw_steps = 10;
+    OutputData output = BowModel::simulate(input, SimulationMode::Static, [](int, int){});
+
+    std::string path = (std::filesystem::temp_directory_path() / "result-files-overwrite.res").string();
+    output.save(path, OutputData::Format::Binary);
+
+    {
+        // Saving a loaded result to its own file, the loaded result still refers to the old file
+        OutputData loaded(path);
+        loaded.save(path, OutputData::Format::Binary);
+        check_states(loaded.statics.states, output.statics.states);
+
+        OutputData reloaded(path);
+        check_states(reloaded.statics.states, output.statics.states);
+
+        // Overwriting the file with a different format
+        output.save(path, OutputData::Format::MsgPack);
+        check_states(loaded.statics.states, output.statics.states);
+        check_states(reloaded.statics.states, output.statics.states);
+        check_states(OutputData(path).statics.states, output.statics.states);
+    }
+
+    REQUIRE(!std::filesystem::exists(path + ".tmp"));
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("result-files-invalid-index")
+{
+    InputData input;
+    input.settings.n_draw_steps = 10;
+    OutputData output = BowModel::simulate(input, SimulationMode::Static, [](int, int){});
+
+    std::string path = (std::filesystem::temp_directory_path() / "result-files-invalid-index.res").string();
+    output.save(path, OutputData::Format::Binary);
+
+    std::vector<char> bytes;
+    {
+        std::ifstream stream(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    // Array size whose number of bytes overflows to zero
+    uint64_t position[2];
+    std::memcpy(position, bytes.data() + 8, sizeof(position));
+    nlohmann::json index = nlohmann::json::from_msgpack(bytes.begin() + position[0], bytes.begin() + position[0] + position[1]);
+    index["statics"]["states"]["kappa"]["rows"] = uint64_t(1) << 61;
+    index["statics"]["states"]["kappa"]["cols"] = 8;
+
+    std::vector<uint8_t> buffer = nlohmann::json::to_msgpack(index);
+    position[1] = buffer.size();
+    bytes.resize(position[0]);
+    bytes.insert(bytes.end(), buffer.begin(), buffer.end());
+    std::memcpy(bytes.data() + 8, position, sizeof(position));
+
+    {
+        std::ofstream stream(path, std::ios::binary);
+        stream.write(bytes.data(), bytes.size());
+    }
+
+    REQUIRE_THROWS(OutputData(path));
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("result-files-layer-matrices")
+{
+    // Older result files contain the stress coefficients as diagonal matrices
+    LayerProperties layer(3);
+    layer.rho = 1.0;
+    layer.E = 1.0;
+    layer.He_back << 1.0, 2.0, 3.0;
+    layer.Hk_belly << -1.0, -2.0, -3.0;
+
+    nlohmann::json obj = layer;
+    obj["He_back"] = MatrixXd(layer.He_back.asDiagonal());
+    obj["Hk_belly"] = MatrixXd(layer.Hk_belly.asDiagonal());
+
+    LayerProperties loaded = obj.get<LayerProperties>();
+    REQUIRE(loaded.He_back == layer.He_back);
+    REQUIRE(loaded.Hk_belly == layer.Hk_belly);
+    REQUIRE(loaded.Hk_back == layer.Hk_back);
+}
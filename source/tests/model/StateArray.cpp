@@ -0,0 +1,31 @@
+#include "solver/model/output/StateArray.hpp"
+#include <catch2/catch.hpp>
+
+TEST_CASE("state-array")
+{
+    StateArray array;
+    array.reserve(10);
+    REQUIRE(array.empty());
+    REQUIRE(array.size() == 0);
+
+    array.push_back(Vector<3>{1.0, 2.0, 3.0});
+    StateArray::Row row = array.append(3);
+    row << 4.0, 5.0, 6.0;
+
+    REQUIRE(array.size() == 2);
+    REQUIRE(array.cols() == 3);
+    REQUIRE(array.front() == Vector<3>(1.0, 2.0, 3.0));
+    REQUIRE(array[1][2] == 6.0);
+    REQUIRE(array.back().sum() == 15.0);
+    REQUIRE(array.data()[3] == 4.0);    // Contiguous, one row per state
+
+    REQUIRE_THROWS(array.append(2));
+
+    // Same serialization as a vector of vectors
+    nlohmann::json obj = array;
+    REQUIRE(obj == nlohmann::json::parse("[[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]]"));
+
+    StateArray copy = obj.get<StateArray>();
+    REQUIRE(copy.size() == 2);
+    REQUIRE(copy[1] == array[1]);
+}
@@ -0,0 +1,154 @@
+#include "solver/model/BowModel.hpp"
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <thread>
+#include <atomic>
+
+// Total number of values of a state field
+template<class Field>
+static size_t count_values(const Field& field)
+{
+    if constexpr(std::is_same_v<Field, StateArray>) {
+        return field.size()*field.cols();
+    }
+    else {
+        return field.size();
+    }
+}
+
+TEST_CASE("state-sinks")
+{
+    InputData input;
+    input.settings.n_draw_steps = 10;
+    input.settings.sampling_rate = 1e5;    // Enough states for multiple chunks
+
+    OutputData output_memory = BowModel::simulate(input, SimulationMode::Dynamic, [](int, int){});
+    const BowStates& states = output_memory.dynamics.states;
+    REQUIRE(states.time.size() > 1000);
+
+    // Summary of the chunked simulation matches the summary of all states at once
+    StateSummary summary(output_memory.setup.limb_properties.layers);
+    summary.add(states);
+
+    REQUIRE(summary.size() == states.time.size());
+    REQUIRE(summary.arrow_departure_index);
+    REQUIRE(*summary.arrow_departure_index == output_memory.dynamics.arrow_departure_index);
+    REQUIRE(summary.final_e_kin_arrow == output_memory.dynamics.final_e_kin_arrow);
+    REQUIRE(summary.max_string_force_index == output_memory.dynamics.max_string_force_index);
+    REQUIRE(summary.max_grip_force_index == output_memory.dynamics.max_grip_force_index);
+    REQUIRE(summary.stresses.get(0).min_index == output_memory.dynamics.min_stress_index[0]);
+    REQUIRE(summary.stresses.get(0).max_index == output_memory.dynamics.max_stress_index[0]);
+    REQUIRE(summary.stresses.get(0).max_value == output_memory.dynamics.max_stress_value[0]);
+
+    // File sink results in the same states, temporary files are removed with the states
+    std::string path = (std::filesystem::temp_directory_path() / "state-sinks").string();
+    {
+        FileSink sink(path);
+        OutputData output_file = BowModel::simulate(input, SimulationMode::Dynamic, [](int, int){}, sink);
+        REQUIRE(std::filesystem::exists(path + ".kappa.tmp"));
+
+        output_file.dynamics.states.visit([&](const char* name, const auto& field) {
+            states.visit([&](const char* other_name, const auto& other_field) {
+                if(std::string(name) == other_name) {
+                    REQUIRE(count_values(field) == count_values(other_field));
+                    REQUIRE(std::equal(field.data(), field.data() + count_values(field), other_field.data()));
+                }
+            });
+        });
+
+        REQUIRE(output_file.dynamics.efficiency == output_memory.dynamics.efficiency);
+    }
+
+    REQUIRE(!std::filesystem::exists(path + ".kappa.tmp"));
+    REQUIRE(!std::filesystem::exists(path + ".time.tmp"));
+}
+
+TEST_CASE("ring-buffer")
+{
+    RingBuffer<int> buffer(2);
+    int value = 1;
+
+    REQUIRE(buffer.try_push(value));
+    value = 2;
+    REQUIRE(buffer.try_push(value));
+    value = 3;
+    REQUIRE(!buffer.try_push(value));    // Full
+
+    REQUIRE(buffer.try_pop(value));
+    REQUIRE(value == 1);
+    value = 3;
+    REQUIRE(buffer.try_push(value));     // Wraps around
+
+    REQUIRE(buffer.try_pop(value));
+    REQUIRE(value == 2);
+    REQUIRE(buffer.try_pop(value));
+    REQUIRE(value == 3);
+    REQUIRE(!buffer.try_pop(value));     // Empty
+
+    // Values arrive in order when pushed and popped concurrently
+    RingBuffer<int> queue(16);
+    const int n = 100000;
+
+    std::thread producer([&] {
+        for(int i = 0; i < n; ++i) {
+            int item = i;
+            while(!queue.try_push(item)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    bool ordered = true;
+    for(int i = 0; i < n; ++i) {
+        int item;
+        while(!queue.try_pop(item)) {
+            std::this_thread::yield();
+        }
+        ordered = ordered && (item == i);
+    }
+    producer.join();
+
+    REQUIRE(ordered);
+}
+
+TEST_CASE("state-sinks-stream")
+{
+    InputData input;
+    input.settings.n_draw_steps = 10;
+
+    MemorySink memory;
+    StreamSink stream(memory, 5, 4);
+    std::atomic<bool> finished = false;
+    OutputData output;
+
+    std::thread simulation([&] {
+        output = BowModel::simulate(input, SimulationMode::Dynamic, [](int, int){}, stream);
+        finished = true;
+    });
+
+    // Read the states while the simulation is running
+    BowStates states;
+    while(!finished) {
+        stream.read(states);
+        std::this_thread::yield();
+    }
+    simulation.join();
+    stream.read(states);
+
+    // The published states are the complete states
+    const BowStates& complete = output.dynamics.states;
+    REQUIRE(states.time.size() == complete.time.size());
+    REQUIRE(std::equal(states.time.begin(), states.time.end(), complete.time.begin()));
+    REQUIRE(states.x_pos_limb.size() == complete.x_pos_limb.size());
+    REQUIRE(std::equal(states.x_pos_limb.data(), states.x_pos_limb.data() + states.x_pos_limb.size()*states.x_pos_limb.cols(), complete.x_pos_limb.data()));
+
+    // Without a consumer the queue fills up and the remaining states stay pending until the end of the simulation
+    MemorySink memory2;
+    StreamSink stream2(memory2, 5, 2);
+    OutputData output2 = BowModel::simulate(input, SimulationMode::Dynamic, [](int, int){}, stream2);
+
+    BowStates states2;
+    REQUIRE(stream2.read(states2));
+    REQUIRE(states2.time == output2.dynamics.states.time);
+    REQUIRE(!stream2.read(states2));
+}
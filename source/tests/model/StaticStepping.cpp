@@ -0,0 +1,70 @@
+#include "solver/model/BowModel.hpp"
+#include "solver/fem/Profiler.hpp"
+#include <catch2/catch.hpp>
+
+// Runs a static simulation of the default bow, returns the output and the number of failed steps
+static OutputData simulate_statics(const InputData& input, const StaticStepping& stepping, unsigned long& failed_steps)
+{
+    Profiler profiler;
+    Profiler::Activation activation(profiler);
+
+    MemorySink sink;
+    OutputData output = BowModel::simulate(input, SimulationMode::Static, [](int, int){}, sink, nullptr, stepping);
+
+    auto it = profiler.get_counters().find("statics/failed_steps");
+    failed_steps = (it != profiler.get_counters().end()) ? it->second : 0;
+
+    return output;
+}
+
+// The output states must be at the requested draw lengths
+static void check_draw_lengths(const InputData& input, const BowStates& states)
+{
+    const unsigned n = input.settings.n_draw_steps;
+    REQUIRE(states.draw_length.size() == n);
+    for(unsigned i = 0; i < n; ++i) {
+        double eta = double(i)/(n - 1);
+        REQUIRE(states.draw_length[i] == (1.0 - eta)*input.dimensions.brace_height + eta*input.dimensions.draw_length);
+    }
+}
+
+TEST_CASE("static-step-control")
+{
+    InputData input;
+    input.settings.n_draw_steps = 20;
+    unsigned long failed_steps;
+
+    // Reference with fixed steps at the output draw lengths
+    StaticStepping fixed;
+    fixed.adaptive = false;
+    OutputData reference = simulate_statics(input, fixed, failed_steps);
+    check_draw_lengths(input, reference.statics.states);
+    REQUIRE(failed_steps == 0);
+
+    // Adaptive steps with interpolated output states
+    OutputData adaptive = simulate_statics(input, StaticStepping(), failed_steps);
+    check_draw_lengths(input, adaptive.statics.states);
+    REQUIRE(failed_steps == 0);
+
+    REQUIRE(adaptive.statics.final_draw_force == Approx(reference.statics.final_draw_force).epsilon(1e-6));
+    REQUIRE(adaptive.statics.drawing_work == Approx(reference.statics.drawing_work).epsilon(1e-6));
+    for(size_t i = 0; i < input.settings.n_draw_steps; ++i) {
+        REQUIRE(adaptive.statics.states.draw_force[i] == Approx(reference.statics.states.draw_force[i]).epsilon(1e-3));
+    }
+
+    // A single step from brace height to full draw with a low iteration limit of the solver fails at first
+    // and succeeds after halving the step
+    input.settings.n_draw_steps = 2;
+    StaticStepping limited;
+    limited.strategy.max_iter = 8;
+
+    OutputData halved = simulate_statics(input, limited, failed_steps);
+    check_draw_lengths(input, halved.statics.states);
+    REQUIRE(failed_steps > 0);
+    REQUIRE(halved.statics.final_draw_force == Approx(reference.statics.final_draw_force).epsilon(1e-6));
+    REQUIRE(halved.statics.drawing_work == Approx(reference.statics.drawing_work).epsilon(1e-6));
+
+    // Fails if the step would have to become smaller than the minimum
+    limited.strategy.max_iter = 3;
+    REQUIRE_THROWS_WITH(simulate_statics(input, limited, failed_steps), "Failed to find the static equilibrium of the drawn bow");
+}
@@ -0,0 +1,70 @@
+#include "solver/model/output/StressEnvelope.hpp"
+#include <catch2/catch.hpp>
+
+TEST_CASE("stress-envelope")
+{
+    const unsigned n_nodes = 20;
+    const unsigned n_states = 5000;    // Multiple threads
+
+    std::vector<LayerProperties> layers(2, LayerProperties(n_nodes));
+    for(auto& layer: layers) {
+        layer.He_back = VectorXd::Random(n_nodes);
+        layer.Hk_back = VectorXd::Random(n_nodes);
+        layer.He_belly = VectorXd::Random(n_nodes);
+        layer.Hk_belly = VectorXd::Random(n_nodes);
+    }
+
+    StateArray epsilon;
+    StateArray kappa;
+    for(unsigned i = 0; i < n_states; ++i) {
+        epsilon.push_back(VectorXd::Random(n_nodes));
+        kappa.push_back(VectorXd::Random(n_nodes));
+    }
+
+    StressEnvelope envelope(layers, true);
+    envelope.add(epsilon, kappa);
+    REQUIRE(envelope.size() == n_states);
+
+    // Sequential reference evaluation
+    for(size_t k = 0; k < layers.size(); ++k) {
+        StressEnvelope::Extrema expected;
+        expected.node_min = VectorXd::Constant(n_nodes, std::numeric_limits<double>::max());
+        expected.node_max = VectorXd::Constant(n_nodes, std::numeric_limits<double>::lowest());
+
+        for(unsigned i = 0; i < n_states; ++i) {
+            VectorXd sigma_back = layers[k].get_stress_back(epsilon[i], kappa[i]);
+            VectorXd sigma_belly = layers[k].get_stress_belly(epsilon[i], kappa[i]);
+
+            for(unsigned j = 0; j < n_nodes; ++j) {
+                for(double sigma: {sigma_back[j], sigma_belly[j]}) {
+                    if(sigma > expected.max_value) {
+                        expected.max_value = sigma;
+                        expected.max_index = {i, j};
+                    }
+                    if(sigma < expected.min_value) {
+                        expected.min_value = sigma;
+                        expected.min_index = {i, j};
+                    }
+                    expected.node_min[j] = std::min(expected.node_min[j], sigma);
+                    expected.node_max[j] = std::max(expected.node_max[j], sigma);
+                }
+            }
+        }
+
+        const StressEnvelope::Extrema& result = envelope.get(k);
+        REQUIRE(result.min_value == expected.min_value);
+        REQUIRE(result.max_value == expected.max_value);
+        REQUIRE(result.min_index == expected.min_index);
+        REQUIRE(result.max_index == expected.max_index);
+        REQUIRE(result.node_min == expected.node_min);
+        REQUIRE(result.node_max == expected.node_max);
+    }
+
+    // Equal values: The first state wins
+    StressEnvelope repeated(layers);
+    repeated.add(epsilon, kappa);
+    repeated.add(epsilon, kappa);
+    REQUIRE(repeated.size() == 2*n_states);
+    REQUIRE(repeated.get(0).max_index == envelope.get(0).max_index);
+    REQUIRE(repeated.get(1).min_index == envelope.get(1).min_index);
+}
@@ -1,5 +1,9 @@
 #include "solver/numerics/CubicSpline.hpp"
+#include "solver/numerics/Linspace.hpp"
 #include <catch2/catch.hpp>
+#include <algorithm>
+#include <random>
+#include <cmath>
 #include <iostream>
 
 TEST_CASE("cubic-spline-interpolation") {
@@ -51,3 +55,48 @@ TEST_CASE("cubic-spline-interpolation") {
     }
 }
 
+TEST_CASE("cubic-spline-batch-evaluation") {
+
+    // Evaluate splines with equally and unequally spaced arguments at sorted and shuffled arguments,
+    // including the knots and points out of bounds, and compare the results to the single evaluation
+
+    std::vector<double> x_uniform = linspace(0.0, 1.0, 11);
+    std::vector<double> x_nonuniform = {0.0, 0.05, 0.1, 0.3, 0.35, 0.6, 0.9, 1.0};
+
+    for(auto& x: {x_uniform, x_nonuniform}) {
+        std::vector<double> y;
+        for(double xi: x) {
+            y.push_back(std::sin(5.0*xi));
+        }
+
+        for(bool monotonic: {false, true}) {
+            CubicSpline spline(x, y, monotonic);
+
+            std::vector<double> args = linspace(-0.2, 1.2, 141);
+            args.insert(args.end(), x.begin(), x.end());
+            std::sort(args.begin(), args.end());
+
+            for(bool shuffle: {false, true}) {
+                if(shuffle) {
+                    std::shuffle(args.begin(), args.end(), std::mt19937(0));
+                }
+
+                std::vector<double> vals, deriv1, deriv2;
+                spline.evaluate(args, &vals, &deriv1, &deriv2);
+
+                REQUIRE(vals.size() == args.size());
+                REQUIRE(deriv1.size() == args.size());
+                REQUIRE(deriv2.size() == args.size());
+                REQUIRE(spline(args) == vals);
+                REQUIRE(spline.deriv1(args) == deriv1);
+                REQUIRE(spline.deriv2(args) == deriv2);
+
+                for(size_t i = 0; i < args.size(); ++i) {
+                    REQUIRE(vals[i] == spline(args[i]));
+                    REQUIRE(deriv1[i] == spline.deriv1(args[i]));
+                    REQUIRE(deriv2[i] == spline.deriv2(args[i]));
+                }
+            }
+        }
+    }
+}
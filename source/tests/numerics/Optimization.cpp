@@ -0,0 +1,51 @@
+#include "solver/numerics/Optimization.hpp"
+#include <catch2/catch.hpp>
+#include <cmath>
+
+TEST_CASE("backtracking-line-search")
+{
+    const double c = 1e-4;
+    const double beta = 0.5;
+    const unsigned iter = 5;
+
+    unsigned evaluations = 0;
+
+    // Residual decreases along the full step: Accepted with a single evaluation
+    auto f_decreasing = [&](double x) {
+        evaluations += 1;
+        return 1.0 - 0.9*x;
+    };
+
+    evaluations = 0;
+    REQUIRE(backtracking_search(f_decreasing, 1.0, c, beta, iter) == 1.0);
+    REQUIRE(evaluations == 1);
+
+    evaluations = 0;
+    REQUIRE(backtracking_golden_section_search(f_decreasing, 1.0, c, beta, iter, 1e-2, 50) == 1.0);
+    REQUIRE(evaluations == 1);
+
+    // Residual increases for all tried steps: Returns zero after iter reductions
+    auto f_increasing = [&](double x) {
+        evaluations += 1;
+        return 1.0 + x;
+    };
+
+    evaluations = 0;
+    REQUIRE(backtracking_search(f_increasing, 1.0, c, beta, iter) == 0.0);
+    REQUIRE(evaluations == iter);
+
+    // Minimum below the smallest tried step: Falls back to the golden section search, which finds it
+    auto f_narrow = [&](double x) {
+        evaluations += 1;
+        return std::abs(x - 0.01);
+    };
+
+    evaluations = 0;
+    REQUIRE(backtracking_search(f_narrow, 0.01, c, beta, iter) == 0.0);
+    REQUIRE(evaluations == iter);
+
+    evaluations = 0;
+    double x = backtracking_golden_section_search(f_narrow, 0.01, c, beta, iter, 1e-3, 50);
+    REQUIRE(x == Approx(0.01).margin(1e-3));
+    REQUIRE(evaluations > iter);
+}
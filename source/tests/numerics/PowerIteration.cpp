@@ -0,0 +1,33 @@
+#include "solver/numerics/PowerIteration.hpp"
+#include <catch2/catch.hpp>
+
+TEST_CASE("power-iteration")
+{
+    // Diagonal matrix with the two highest eigenvalues close together
+    VectorXd d(6);
+    d << 1.0, 2.0, 4.0, 8.0, 9.99, 10.0;
+
+    auto A = [&](const VectorXd& x, VectorXd& y) {
+        y = d.cwiseProduct(x);
+    };
+
+    // Converged: The Rayleigh quotient is a lower bound, the residual covers the remaining distance to the largest eigenvalue
+    VectorXd x = VectorXd::Ones(6);
+    PowerIterationResult result = power_iteration(A, x, 1e-3, 1000);
+    REQUIRE(result.converged);
+    REQUIRE(result.lambda <= 10.0);
+    REQUIRE(result.lambda + result.residual >= 10.0);
+    REQUIRE(result.residual <= 1e-3*result.lambda);
+
+    // Not converged within the maximum number of iterations
+    x = VectorXd::Ones(6);
+    result = power_iteration(A, x, 1e-3, 5);
+    REQUIRE(!result.converged);
+    REQUIRE(result.lambda <= 10.0);
+
+    // Zero matrix
+    x = VectorXd::Ones(6);
+    result = power_iteration([](const VectorXd& x, VectorXd& y) { y.setZero(); }, x, 1e-3, 1000);
+    REQUIRE(result.converged);
+    REQUIRE(result.lambda == 0.0);
+}